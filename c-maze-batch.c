@@ -0,0 +1,366 @@
+// C-MAZE BATCH - Non-interactive board generator for offline maze pools
+// Generates every seed x size x algorithm combination exactly like the game's
+// initializeMazeState() (single player) and appends each board to a maze library
+// file (see maze-library.h). Nothing is drawn, so throughput is bound by generation and disk.
+// Boards are generated on all cores by a work-stealing pool (maze-pool.h) and written
+// in a fixed order, so the output file is identical for any thread count.
+//
+// Build: gcc -O2 -pthread c-maze-batch.c maze-library.c maze-pool.c maze-cli.c maze-engine.c -o c-maze-batch
+// Usage: ./c-maze-batch --out pool.cmzl [--sizes 21,51,401x201] [--algorithms 1,2,3,4,5,6,7,8,9] [--seeds 1-100000] [-j N]
+//        ./c-maze-batch --out maze.txt --stream 101x1000001 [--seeds S]   (one Eller's maze as text, any height)
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>    // For isspace()
+#include <errno.h>    // For errno, ERANGE
+#include <limits.h>   // For UINT_MAX
+
+#include "maze-engine.h"
+#include "maze-library.h"
+#include "maze-pool.h"
+#include "maze-cli.h"
+
+// --- Batch Defaults ---
+#define BATCH_MAX_LIST 32 // Max number of sizes/algorithms accepted on the command line
+#define BATCH_PROGRESS_INTERVAL 10000 // Boards between progress lines
+#define BATCH_CHUNK_BYTES (64 << 20) // Encoded boards held in memory between writes
+#define BATCH_MAX_CHUNK 8192 // Max boards generated per parallel round
+#define BATCH_STREAM_BUFFER (1 << 20) // stdio buffer for --stream output
+
+// --- Structs ---
+// Output slot of one board in the current chunk
+typedef struct {
+    MazeLibraryRecord record;   // Encoded board, reused across chunks
+    int status;                 // 1 = encoded, 0 = unreachable exit (skipped), -1 = error
+} BatchSlot;
+
+// Per-worker generation state
+typedef struct {
+    MazeContext ctx;    // Grid, RNG and scratch buffers of this worker
+    Cell *dots;         // Bonus dot positions of the current board
+    int dotCapacity;
+} BatchWorker;
+
+// Shared, read-only description of the chunk being generated (plus per-worker/per-slot output)
+typedef struct {
+    int rows, cols;             // Size of every board in the chunk
+    const int *algorithms;
+    unsigned int firstSeed;
+    unsigned long long seedCount;   // Seeds per algorithm
+    unsigned long long firstJob;    // Job number of slot 0 within this size
+    BatchWorker *workers;
+    BatchSlot *slots;
+} BatchChunk;
+
+// --- Function Prototypes ---
+int parseSeedRange(const char* text, unsigned int* first, unsigned int* last);  // Parses "A-B" or "N"
+int generateBoard(MazeContext* ctx, unsigned int seed, int algorithm, Cell* dots, int* exitX, int* exitY); // Builds one board, returns dot count
+void generateChunkBoard(void* user, size_t index, int worker);  // Pool task: generates and encodes one slot
+int streamTextMaze(const char* outPath, const char* size, unsigned int seed);  // --stream: writes one Eller's maze as text
+int writeTextRow(void* user, long long x, const char* row, int cols);   // Row sink of streamTextMaze()
+void printUsage(const char* program);   // Prints command line help
+
+
+// === MAIN FUNCTION ===
+int main(int argc, char* argv[]) {
+    const char* outPath = NULL;
+    const char* streamSize = NULL;
+    int sizeCols[BATCH_MAX_LIST] = {DEFAULT_SIZE}, sizeRows[BATCH_MAX_LIST] = {DEFAULT_SIZE};
+    int numSizes = 1;
+    int algorithms[BATCH_MAX_LIST];
+    int numAlgorithms = NUM_ALGORITHMS;
+    unsigned int firstSeed = 1, lastSeed = 100;
+    int threads = getMazeProcessorCount();
+
+    for (int i = 0; i < NUM_ALGORITHMS; i++) algorithms[i] = i + 1;
+
+    // --- Parse Command Line ---
+    for (int i = 1; i < argc; i++) {
+        const char* value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "--out") == 0 && value) {
+            outPath = value; i++;
+        } else if (strcmp(argv[i], "--sizes") == 0 && value) {
+            numSizes = parseMazeSizeList(value, sizeCols, sizeRows, BATCH_MAX_LIST); i++;
+        } else if (strcmp(argv[i], "--algorithms") == 0 && value) {
+            numAlgorithms = parseMazeIntList(value, algorithms, BATCH_MAX_LIST); i++;
+        } else if (strcmp(argv[i], "--seeds") == 0 && value) {
+            if (!parseSeedRange(value, &firstSeed, &lastSeed)) {
+                fprintf(stderr, "Error: --seeds expects A-B or N (seeds 1..N), got '%s'.\n", value);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(argv[i], "--stream") == 0 && value) {
+            streamSize = value; i++;
+        } else if ((strcmp(argv[i], "-j") == 0 || strcmp(argv[i], "--threads") == 0) && value) {
+            threads = atoi(value); i++;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    // --- Validate Settings ---
+    if (!outPath || numSizes <= 0 || numAlgorithms <= 0 || threads <= 0) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (streamSize) return streamTextMaze(outPath, streamSize, firstSeed) ? 0 : 1;
+    for (int i = 0; i < numSizes; i++) {
+        if (sizeCols[i] < MIN_SIZE || sizeRows[i] < MIN_SIZE || sizeCols[i] > MAX_SIZE || sizeRows[i] > MAX_SIZE) {
+            fprintf(stderr, "Error: Maze size %dx%d is outside %d-%d.\n", sizeCols[i], sizeRows[i], MIN_SIZE, MAX_SIZE);
+            return 1;
+        }
+        if (sizeCols[i] % 2 == 0) sizeCols[i]++; // Generators expect odd sizes
+        if (sizeRows[i] % 2 == 0) sizeRows[i]++;
+    }
+    for (int i = 0; i < numAlgorithms; i++) {
+        if (algorithms[i] < 1 || algorithms[i] > NUM_ALGORITHMS) {
+            fprintf(stderr, "Error: Algorithm %d is out of range (1-%d).\n", algorithms[i], NUM_ALGORITHMS);
+            return 1;
+        }
+    }
+
+    MazeLibraryWriter writer;
+    if (!openMazeLibraryWriter(&writer, outPath)) return 1;
+    MazePool* pool = createMazePool(threads);
+    if (!pool) {
+        closeMazeLibraryWriter(&writer);
+        return 1;
+    }
+    threads = getMazePoolThreads(pool);
+    BatchWorker* workers = (BatchWorker*)calloc((size_t)threads, sizeof(BatchWorker));
+    BatchSlot* slots = (BatchSlot*)calloc(BATCH_MAX_CHUNK, sizeof(BatchSlot));
+    if (!workers || !slots) {
+        perror("Error allocating batch workers");
+        exit(EXIT_FAILURE);
+    }
+
+    // --- Generate Boards ---
+    // Jobs run size by size; within a size, job j is algorithm j / seedCount and seed
+    // firstSeed + j % seedCount, the order the boards are written in. Each chunk is
+    // generated in parallel into its slots, then written out by this thread in order.
+    long long failures = 0;
+    int aborted = 0;  // Set when a board or the file fails; stops the loops and skips the report
+    long long nextProgress = BATCH_PROGRESS_INTERVAL;
+    unsigned long long seedCount = (unsigned long long)lastSeed - firstSeed + 1;
+    double started = getMazeCliSeconds();
+    for (int s = 0; s < numSizes && !aborted; s++) {
+        // Chunk length: as many boards as fit the memory budget, at least one per thread
+        size_t recordEstimate = MAZE_LIBRARY_RECORD_HEADER_SIZE + (size_t)(sizeRows[s] + sizeCols[s]) +
+            2 * (size_t)((sizeRows[s] - 1) / 2) * (((size_t)(sizeCols[s] - 1) / 2 + 63) / 64) * sizeof(uint64_t);
+        size_t chunkLength = BATCH_CHUNK_BYTES / recordEstimate;
+        if (chunkLength < (size_t)threads) chunkLength = (size_t)threads;
+        if (chunkLength > BATCH_MAX_CHUNK) chunkLength = BATCH_MAX_CHUNK;
+
+        unsigned long long jobs = seedCount * (unsigned long long)numAlgorithms;
+        BatchChunk chunk = {sizeRows[s], sizeCols[s], algorithms, firstSeed, seedCount, 0, workers, slots};
+        while (chunk.firstJob < jobs && !aborted) {
+            size_t count = (jobs - chunk.firstJob < chunkLength) ? (size_t)(jobs - chunk.firstJob) : chunkLength;
+            mazePoolParallelFor(pool, count, generateChunkBoard, &chunk);
+
+            // --- Write the chunk in job order ---
+            for (size_t i = 0; i < count; i++) {
+                if (slots[i].status < 0) {
+                    aborted = 1;
+                    break;
+                }
+                if (slots[i].status == 0) {
+                    unsigned long long job = chunk.firstJob + i;
+                    fprintf(stderr, "Warning: Seed %u (%dx%d, %s) has an unreachable exit; skipped.\n",
+                            (unsigned int)(firstSeed + job % seedCount), sizeCols[s], sizeRows[s],
+                            getAlgorithmName(algorithms[job / seedCount]));
+                    failures++;
+                } else if (!writeMazeLibraryRecord(&writer, &slots[i].record)) {
+                    aborted = 1;
+                    break;
+                }
+            }
+            chunk.firstJob += count;
+            if (writer.recordsWritten >= nextProgress) {
+                fprintf(stderr, "%lld boards written...\n", writer.recordsWritten);
+                nextProgress = (writer.recordsWritten / BATCH_PROGRESS_INTERVAL + 1) * BATCH_PROGRESS_INTERVAL;
+            }
+        }
+    }
+
+    // --- Cleanup ---
+    destroyMazePool(pool);
+    for (int i = 0; i < threads; i++) {
+        freeMazeContext(&workers[i].ctx);
+        free(workers[i].dots);
+    }
+    for (int i = 0; i < BATCH_MAX_CHUNK; i++) freeMazeLibraryRecord(&slots[i].record);
+    free(workers);
+    free(slots);
+    if (aborted) {
+        closeMazeLibraryWriter(&writer);
+        return 1;
+    }
+
+    // --- Report ---
+    long long boards = writer.recordsWritten;
+    long long bytes = writer.bytesWritten;
+    int closed = closeMazeLibraryWriter(&writer);
+    double seconds = getMazeCliSeconds() - started;
+    fprintf(stderr, "Wrote %lld boards (%.1f MB) to %s in %.2f s on %d threads", boards, bytes / 1e6, outPath, seconds, threads);
+    if (seconds > 0.0) fprintf(stderr, " | %.0f boards/s, %.1f MB/s", boards / seconds, bytes / 1e6 / seconds);
+    fprintf(stderr, "\n");
+    if (!closed) return 1;
+    return failures ? 2 : 0;
+}
+
+// === BATCH FUNCTIONS ===
+
+/*
+ * Parses an inclusive seed range "A-B", or "N" meaning seeds 1..N.
+ * Seed 0 is excluded like in the game. Returns 1 on success, 0 on malformed input
+ * (including negative numbers, which strtoul() would wrap, and values above UINT_MAX).
+ */
+int parseSeedRange(const char* text, unsigned int* first, unsigned int* last) {
+    char* endPtr;
+    while (isspace((unsigned char)*text)) text++;
+    if (*text == '-') return 0;
+    errno = 0;
+    unsigned long a = strtoul(text, &endPtr, 10);
+    if (endPtr == text || errno == ERANGE || a > UINT_MAX) return 0;
+    if (*endPtr == '\0') {
+        *first = 1;
+        *last = (unsigned int)a;
+    } else if (*endPtr == '-') {
+        const char* p = endPtr + 1;
+        while (isspace((unsigned char)*p)) p++;
+        if (*p == '-') return 0;
+        unsigned long b = strtoul(p, &endPtr, 10);
+        if (endPtr == p || *endPtr != '\0' || errno == ERANGE || b > UINT_MAX) return 0;
+        *first = (unsigned int)a;
+        *last = (unsigned int)b;
+    } else {
+        return 0;
+    }
+    return *first != 0 && *first <= *last;
+}
+
+/*
+ * Regenerates ctx->grid in place for one seed, following initializeMazeState():
+ * seed the context's RNG, generate from (1, 1), place the exit, then the bonus dots.
+ * Returns the number of dots written to 'dots', or -1 if the exit is unreachable
+ * (only checked for algorithms that are not connected by construction).
+ */
+int generateBoard(MazeContext* ctx, unsigned int seed, int algorithm, Cell* dots, int* exitX, int* exitY) {
+    fillMazeGrid(&ctx->grid, WALL_CHAR); // Reuse the allocation instead of reallocating per board
+    mazeRngSeed(&ctx->rng, seed);
+    generateMaze(ctx, algorithm, 1, 1);
+    MAZE_CELL(&ctx->grid, 1, 1) = PATH_CHAR;
+    placeMazeExit(&ctx->grid, exitX, exitY);
+    if (!algorithmGuaranteesConnectivity(algorithm) &&
+        !isCellReachable(&ctx->grid, &ctx->bfs, 1, 1, *exitX, *exitY)) {
+        return -1;
+    }
+    return placeMazeBonusDots(ctx, *exitX, *exitY, -1, -1, dots); // No second player to avoid
+}
+
+/*
+ * Pool task: generates board 'index' of the current chunk on the worker's own context
+ * and encodes it into slot 'index'. Workers share nothing but read-only chunk data,
+ * and every board depends only on its seed, so the output never depends on which
+ * worker ran which job.
+ */
+void generateChunkBoard(void* user, size_t index, int worker) {
+    BatchChunk* chunk = (BatchChunk*)user;
+    BatchWorker* state = &chunk->workers[worker];
+    BatchSlot* slot = &chunk->slots[index];
+    unsigned long long job = chunk->firstJob + index;
+    int algorithm = chunk->algorithms[job / chunk->seedCount];
+    unsigned int seed = (unsigned int)(chunk->firstSeed + job % chunk->seedCount);
+
+    // --- (Re)size the worker's grid when the board size changes ---
+    if (state->ctx.grid.rows != chunk->rows || state->ctx.grid.cols != chunk->cols) {
+        freeMazeGrid(&state->ctx.grid);
+        allocateMazeGrid(&state->ctx.grid, chunk->rows, chunk->cols);
+    }
+
+    // --- Grow the dot list; checked every job so a failed grow is never skipped ---
+    int dotTarget = getBonusDotTarget(&state->ctx.grid);
+    if (dotTarget > state->dotCapacity) {
+        Cell* grown = (Cell*)realloc(state->dots, (size_t)dotTarget * sizeof(Cell));
+        if (!grown) {
+            perror("Error allocating bonus dot list");
+            slot->status = -1;
+            return;
+        }
+        state->dots = grown;
+        state->dotCapacity = dotTarget;
+    }
+
+    int exitX, exitY;
+    int dotCount = generateBoard(&state->ctx, seed, algorithm, state->dots, &exitX, &exitY);
+    if (dotCount < 0) {
+        slot->status = 0;
+        return;
+    }
+    slot->status = encodeMazeLibraryRecord(&slot->record, &state->ctx.grid, seed, algorithm,
+                                           exitX, exitY, state->dots, dotCount) ? 1 : -1;
+}
+
+/*
+ * --stream mode: writes a single Eller's maze of 'size' ("WIDTHxHEIGHT") as text, one
+ * line per grid row ('#' = wall), to outPath ("-" for stdout). Rows go straight from
+ * the generator to the file, so memory stays O(width) and the height is unlimited.
+ * Returns 1 on success, 0 on error (reported).
+ */
+int streamTextMaze(const char* outPath, const char* size, unsigned int seed) {
+    char* endPtr;
+    long width = strtol(size, &endPtr, 10);
+    long long height = (*endPtr == 'x' || *endPtr == 'X') ? strtoll(endPtr + 1, &endPtr, 10) : 0;
+    if (*endPtr != '\0' || width < MIN_SIZE || width > MAX_SIZE || height < MIN_SIZE) {
+        fprintf(stderr, "Error: --stream expects WIDTHxHEIGHT with width %d-%d and height of at least %d.\n",
+                MIN_SIZE, MAX_SIZE, MIN_SIZE);
+        return 0;
+    }
+    if (width % 2 == 0) width++; // Generators expect odd sizes
+    if (height % 2 == 0) height++;
+
+    FILE* file = (strcmp(outPath, "-") == 0) ? stdout : fopen(outPath, "wb");
+    if (!file) {
+        perror("Error opening stream output file");
+        return 0;
+    }
+    setvbuf(file, NULL, _IOFBF, BATCH_STREAM_BUFFER);
+
+    MazeRng rng;
+    mazeRngSeed(&rng, seed);
+    double started = getMazeCliSeconds();
+    int ok = streamEllerMaze(&rng, height, (int)width, writeTextRow, file);
+    if (fflush(file) != 0) ok = 0;
+    if (file != stdout && fclose(file) != 0) ok = 0;
+    if (!ok) {
+        perror("Error writing streamed maze");
+        return 0;
+    }
+    double seconds = getMazeCliSeconds() - started;
+    fprintf(stderr, "Streamed a %ldx%lld Eller's maze (seed %u) in %.2f s", width, height, seed, seconds);
+    if (seconds > 0.0) fprintf(stderr, " | %.0f cells/s", (double)width * (double)height / seconds);
+    fprintf(stderr, "\n");
+    return 1;
+}
+
+// Row sink of streamTextMaze(): writes one grid row as a text line. Returns 0 on write errors.
+int writeTextRow(void* user, long long x, const char* row, int cols) {
+    FILE* file = (FILE*)user;
+    (void)x;
+    for (int y = 0; y < cols; y++) {
+        if (putc(row[y] == WALL_CHAR ? '#' : row[y], file) == EOF) return 0;
+    }
+    return putc('\n', file) != EOF;
+}
+
+// Prints command line help to stderr.
+void printUsage(const char* program) {
+    fprintf(stderr, "Usage: %s --out FILE [--sizes 21,51,401x201] [--algorithms 1,2,3,4,5,6,7,8,9] [--seeds A-B] [-j N]\n", program);
+    fprintf(stderr, "  --out         Maze library file; created if missing, appended to otherwise\n");
+    fprintf(stderr, "  --sizes       Comma separated maze sizes, N or WIDTHxHEIGHT (odd; even sizes are rounded up; default %d)\n", DEFAULT_SIZE);
+    fprintf(stderr, "  --algorithms  1=Prim's 2=Kruskal's 3=Wilson's 4=Recursive Backtracker 5=Recursive Backtracker (Alternative) 6=Eller's 7=Binary Tree 8=Sidewinder 9=Recursive Division\n");
+    fprintf(stderr, "  --seeds       Inclusive seed range A-B, or N for seeds 1-N (default 1-100)\n");
+    fprintf(stderr, "  -j, --threads Worker threads (default: one per CPU); the output does not depend on it\n");
+    fprintf(stderr, "  --stream WxH  Instead: write one Eller's maze of any height as text to --out (- = stdout), seed = first of --seeds\n");
+}
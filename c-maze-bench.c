@@ -0,0 +1,405 @@
+// C-MAZE BENCH - Headless benchmark for the maze generation algorithms
+// Sweeps maze size x algorithm x seed without touching the console and reports
+// throughput (cells/second), latency percentiles and peak memory per configuration.
+// Note: Uses POSIX process APIs (fork, wait4) and runs on Linux.
+//
+// Build: gcc -O2 -pthread c-maze-bench.c maze-tiled.c maze-pool.c maze-chunks.c maze-cli.c maze-engine.c -o c-maze-bench
+// Usage: ./c-maze-bench [--sizes 21,51,101,401x201] [--algorithms 1,2,3,4,5,6,7,8,9] [--seeds 20] [--first-seed 1]
+//                       [--tile 256 [-j N]] [--hybrid 30] [--world 1000] [--csv]
+#define _GNU_SOURCE // For wait4()
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>       // For fork(), pipe(), read(), write()
+#include <sys/resource.h> // For struct rusage
+#include <sys/wait.h>     // For wait4()
+
+#include "maze-engine.h"
+#include "maze-tiled.h"
+#include "maze-pool.h"
+#include "maze-cli.h"
+#include "maze-chunks.h"
+
+// --- Benchmark Defaults ---
+#define BENCH_MAX_LIST 32 // Max number of sizes/algorithms accepted on the command line
+#define BENCH_DEFAULT_SEEDS 20
+#define BENCH_NAME_WIDTH(wide) ((wide) ? 60 : 40) // Algorithm column width (wide for --tile and --world names)
+#define BENCH_WORLD_CACHE 8   // Chunk cache of --world runs: small, so the walk keeps evicting
+static const int defaultSizes[] = {21, 51, 101, 201, 401};
+
+// --- Structs ---
+// Tiled generation settings (tileCells == 0: plain generateMaze())
+typedef struct {
+    int tileCells;  // Lattice cells per tile side
+    int threads;    // Pool size
+} BenchTiling;
+
+// Results reported by a benchmark child process back to the parent
+typedef struct {
+    int runs;             // Number of mazes generated
+    double totalSeconds;  // Sum of all generation latencies
+    double p50, p90, p99, maxMs; // Latency percentiles in milliseconds
+} BenchResult;
+
+// --- Function Prototypes ---
+int compareDoubles(const void* a, const void* b);   // qsort comparator for latencies
+double percentile(const double* sorted, int count, double p);   // Nearest-rank percentile
+uint64_t hashChunkBytes(const MazeChunk* chunk);   // FNV-1a hash of a chunk's cells
+int checkChunkSeams(const MazeChunk* chunk);    // 1 if both seams have exactly one opening, on a lattice row/column
+void runWorldConfiguration(int algorithm, unsigned int firstSeed, int seeds, int steps, BenchResult* result); // Times chunk generation along a walk, then checks regeneration
+void runConfiguration(int rows, int cols, int algorithm, unsigned int firstSeed, int seeds, BenchTiling tiling, int hybridPercent, BenchResult* result); // Times one size/algorithm pair
+int benchConfiguration(int rows, int cols, int algorithm, unsigned int firstSeed, int seeds, BenchTiling tiling, int hybridPercent, int worldSteps, int csv); // Forks, runs and reports one configuration
+void printUsage(const char* program);   // Prints command line help
+
+
+// === MAIN FUNCTION ===
+int main(int argc, char* argv[]) {
+    int sizeCols[BENCH_MAX_LIST], sizeRows[BENCH_MAX_LIST];
+    int numSizes = sizeof(defaultSizes) / sizeof(defaultSizes[0]);
+    int algorithms[BENCH_MAX_LIST];
+    int numAlgorithms = NUM_ALGORITHMS;
+    int seeds = BENCH_DEFAULT_SEEDS;
+    unsigned int firstSeed = 1;
+    int csv = 0;
+    int hybridPercent = -1; // Aldous-Broder share for the extra Wilson's rows (-1: none)
+    int worldSteps = 0;     // Chunk steps per --world walk (0: size sweep instead)
+    BenchTiling tiling = {0, getMazeProcessorCount()};
+
+    memcpy(sizeCols, defaultSizes, sizeof(defaultSizes));
+    memcpy(sizeRows, defaultSizes, sizeof(defaultSizes));
+    for (int i = 0; i < NUM_ALGORITHMS; i++) algorithms[i] = i + 1;
+
+    // --- Parse Command Line ---
+    for (int i = 1; i < argc; i++) {
+        const char* value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "--sizes") == 0 && value) {
+            numSizes = parseMazeSizeList(value, sizeCols, sizeRows, BENCH_MAX_LIST); i++;
+        } else if (strcmp(argv[i], "--algorithms") == 0 && value) {
+            numAlgorithms = parseMazeIntList(value, algorithms, BENCH_MAX_LIST); i++;
+        } else if (strcmp(argv[i], "--seeds") == 0 && value) {
+            seeds = atoi(value); i++;
+        } else if (strcmp(argv[i], "--first-seed") == 0 && value) {
+            firstSeed = (unsigned int)strtoul(value, NULL, 10); i++;
+        } else if (strcmp(argv[i], "--tile") == 0 && value) {
+            tiling.tileCells = atoi(value); i++;
+            if (tiling.tileCells <= 0) seeds = 0; // Reported below
+        } else if ((strcmp(argv[i], "-j") == 0 || strcmp(argv[i], "--threads") == 0) && value) {
+            tiling.threads = atoi(value); i++;
+        } else if (strcmp(argv[i], "--hybrid") == 0 && value) {
+            hybridPercent = atoi(value); i++;
+            if (hybridPercent < 0 || hybridPercent > 100) seeds = 0; // Reported below
+        } else if (strcmp(argv[i], "--world") == 0 && value) {
+            worldSteps = atoi(value); i++;
+            if (worldSteps <= 0) seeds = 0; // Reported below
+        } else if (strcmp(argv[i], "--csv") == 0) {
+            csv = 1;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    // --- Validate Settings ---
+    if (numSizes <= 0 || numAlgorithms <= 0 || seeds <= 0 || tiling.threads <= 0) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (hybridPercent >= 0 && tiling.tileCells > 0) {
+        fprintf(stderr, "Error: --hybrid cannot be combined with --tile.\n");
+        return 1;
+    }
+    if (worldSteps > 0 && (tiling.tileCells > 0 || hybridPercent >= 0)) {
+        fprintf(stderr, "Error: --world cannot be combined with --tile or --hybrid.\n");
+        return 1;
+    }
+    for (int i = 0; i < numSizes; i++) {
+        if (sizeCols[i] < MIN_SIZE || sizeRows[i] < MIN_SIZE || sizeCols[i] > MAX_SIZE || sizeRows[i] > MAX_SIZE) {
+            fprintf(stderr, "Error: Maze size %dx%d is outside %d-%d.\n", sizeCols[i], sizeRows[i], MIN_SIZE, MAX_SIZE);
+            return 1;
+        }
+        if (sizeCols[i] % 2 == 0) sizeCols[i]++; // Generators expect odd sizes
+        if (sizeRows[i] % 2 == 0) sizeRows[i]++;
+    }
+    if (worldSteps > 0) { // One row per algorithm; chunks have a fixed size
+        numSizes = 1;
+        sizeCols[0] = sizeRows[0] = MAZE_CHUNK_SIZE;
+    }
+    for (int i = 0; i < numAlgorithms; i++) {
+        if (algorithms[i] < 1 || algorithms[i] > NUM_ALGORITHMS) {
+            fprintf(stderr, "Error: Algorithm %d is out of range (1-%d).\n", algorithms[i], NUM_ALGORITHMS);
+            return 1;
+        }
+    }
+
+    // --- Run Sweep ---
+    if (csv) {
+        printf("size,algorithm,seeds,cells_per_second,p50_ms,p90_ms,p99_ms,max_ms,peak_rss_kib,status\n");
+    } else {
+        printf("%-11s %-*s %6s %14s %9s %9s %9s %9s %12s\n",
+               "Size", BENCH_NAME_WIDTH(tiling.tileCells > 0 || worldSteps > 0), "Algorithm", "Seeds", "Cells/s", "p50 ms", "p90 ms", "p99 ms", "Max ms", "Peak RSS KiB");
+    }
+    int failures = 0;
+    for (int s = 0; s < numSizes; s++) {
+        for (int a = 0; a < numAlgorithms; a++) {
+            if (!benchConfiguration(sizeRows[s], sizeCols[s], algorithms[a], firstSeed, seeds, tiling, -1, worldSteps, csv)) failures++;
+            // Hybrid Wilson's right below exact Wilson's, same seeds, for comparison
+            if (algorithms[a] == ALGORITHM_WILSON && hybridPercent >= 0 &&
+                !benchConfiguration(sizeRows[s], sizeCols[s], algorithms[a], firstSeed, seeds, tiling, hybridPercent, 0, csv)) failures++;
+        }
+    }
+    return failures ? 2 : 0;
+}
+
+// === BENCHMARK FUNCTIONS ===
+
+int compareDoubles(const void* a, const void* b) {
+    double da = *(const double*)a, db = *(const double*)b;
+    return (da > db) - (da < db);
+}
+
+// Nearest-rank percentile of an ascending array (p in 0..100).
+double percentile(const double* sorted, int count, double p) {
+    int rank = (int)((p / 100.0) * count + 0.999999);
+    if (rank < 1) rank = 1;
+    if (rank > count) rank = count;
+    return sorted[rank - 1];
+}
+
+/*
+ * Generates 'seeds' mazes of the given size with one algorithm and fills 'result'.
+ * Each run is timed from allocation to the end of generation; freeing is excluded.
+ * Seeding matches the game: mazeRngSeed(seed) immediately before generation.
+ * With tiling, boards come from generateTiledMaze() on a pool created before the runs.
+ * With hybridPercent >= 0, boards come from generateHybridWilsonMaze() instead.
+ */
+void runConfiguration(int rows, int cols, int algorithm, unsigned int firstSeed, int seeds, BenchTiling tiling, int hybridPercent, BenchResult* result) {
+    double* latencies = (double*)malloc((size_t)seeds * sizeof(double));
+    if (!latencies) {
+        perror("Error allocating latency array");
+        exit(EXIT_FAILURE);
+    }
+
+    MazePool* pool = NULL;
+    if (tiling.tileCells > 0) {
+        pool = createMazePool(tiling.threads);
+        if (!pool) exit(EXIT_FAILURE);
+    }
+
+    MazeContext ctx = {0};
+    double total = 0.0;
+    for (int i = 0; i < seeds; i++) {
+        mazeRngSeed(&ctx.rng, firstSeed + (unsigned int)i);
+        double start = getMazeCliSeconds();
+        allocateMazeGrid(&ctx.grid, rows, cols);
+        if (pool) {
+            if (!generateTiledMaze(pool, &ctx.grid, firstSeed + (unsigned int)i, algorithm, tiling.tileCells)) exit(EXIT_FAILURE);
+        } else if (hybridPercent >= 0) {
+            generateHybridWilsonMaze(&ctx, 1, 1, hybridPercent);
+        } else {
+            generateMaze(&ctx, algorithm, 1, 1);
+        }
+        double elapsed = getMazeCliSeconds() - start;
+        freeMazeGrid(&ctx.grid);
+
+        latencies[i] = elapsed * 1000.0;
+        total += elapsed;
+    }
+
+    freeMazeContext(&ctx);
+    destroyMazePool(pool);
+
+    qsort(latencies, seeds, sizeof(double), compareDoubles);
+    result->runs = seeds;
+    result->totalSeconds = total;
+    result->p50 = percentile(latencies, seeds, 50.0);
+    result->p90 = percentile(latencies, seeds, 90.0);
+    result->p99 = percentile(latencies, seeds, 99.0);
+    result->maxMs = latencies[seeds - 1];
+    free(latencies);
+}
+
+// FNV-1a hash of every cell of a chunk, to compare a chunk with its regenerated copy.
+uint64_t hashChunkBytes(const MazeChunk* chunk) {
+    uint64_t h = 0xCBF29CE484222325ULL;
+    for (size_t i = 0; i < sizeof(chunk->cells); i++) {
+        h = (h ^ (unsigned char)chunk->cells[i]) * 0x100000001B3ULL;
+    }
+    return h;
+}
+
+/*
+ * Checks the two seams a chunk owns (its first row and first column): each must have
+ * exactly one opening, on an odd (lattice) position, or the neighbour across it would
+ * be cut off or joined through a wall corner. Returns 1 if both are fine.
+ */
+int checkChunkSeams(const MazeChunk* chunk) {
+    int northOpen = 0, westOpen = 0;
+    for (int i = 1; i < MAZE_CHUNK_SIZE; i++) {
+        if (MAZE_CHUNK_CELL(chunk, 0, i) == PATH_CHAR) northOpen += (i % 2 == 1) ? 1 : 2;
+        if (MAZE_CHUNK_CELL(chunk, i, 0) == PATH_CHAR) westOpen += (i % 2 == 1) ? 1 : 2;
+    }
+    return northOpen == 1 && westOpen == 1 && MAZE_CHUNK_CELL(chunk, 0, 0) == WALL_CHAR;
+}
+
+/*
+ * --world mode: walks 'steps' chunks (a random walk over the chunk grid, so every step
+ * crosses a chunk border) through a BENCH_WORLD_CACHE chunk cache, hashing each chunk
+ * as it is reached and checking its seams. Then evicts every chunk and replays the walk:
+ * every chunk must regenerate byte for byte. Each chunk generation is one timed run.
+ * A mismatch is reported and fails the configuration.
+ */
+void runWorldConfiguration(int algorithm, unsigned int firstSeed, int seeds, int steps, BenchResult* result) {
+    static const int moves[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}}; // N, S, W, E
+    uint64_t* hashes = (uint64_t*)malloc((size_t)steps * sizeof(uint64_t));
+    long long maxRuns = 2LL * steps * seeds; // Upper bound: every step of both passes a miss
+    double* latencies = (double*)malloc((size_t)maxRuns * sizeof(double));
+    if (!hashes || !latencies) {
+        perror("Error allocating world walk arrays");
+        exit(EXIT_FAILURE);
+    }
+
+    int runs = 0;
+    double total = 0.0;
+    for (int i = 0; i < seeds; i++) {
+        unsigned int seed = firstSeed + (unsigned int)i;
+        MazeChunkWorld world;
+        if (!openMazeChunkWorld(&world, seed, algorithm, BENCH_WORLD_CACHE)) exit(EXIT_FAILURE);
+
+        for (int pass = 0; pass < 2; pass++) {
+            MazeRng walk;
+            mazeRngSeed(&walk, seed); // Same walk on both passes
+            long long chunkX = 0, chunkY = 0;
+            for (int step = 0; step < steps; step++) {
+                long long generatedBefore = world.generated;
+                double start = getMazeCliSeconds();
+                const MazeChunk* chunk = getMazeChunk(&world, chunkX, chunkY);
+                double elapsed = getMazeCliSeconds() - start;
+                if (world.generated != generatedBefore) { // Only misses are timed
+                    latencies[runs++] = elapsed * 1000.0;
+                    total += elapsed;
+                }
+
+                uint64_t hash = hashChunkBytes(chunk);
+                if (pass == 0) {
+                    hashes[step] = hash;
+                    if (!checkChunkSeams(chunk)) {
+                        fprintf(stderr, "Error: Chunk (%lld, %lld) of seed %u has a broken seam.\n", chunkX, chunkY, seed);
+                        exit(EXIT_FAILURE);
+                    }
+                } else if (hash != hashes[step]) {
+                    fprintf(stderr, "Error: Chunk (%lld, %lld) of seed %u changed after eviction.\n", chunkX, chunkY, seed);
+                    exit(EXIT_FAILURE);
+                }
+
+                int move = (int)mazeRandBelow(&walk, 4);
+                chunkX += moves[move][0];
+                chunkY += moves[move][1];
+            }
+            evictFarMazeChunks(&world, 0, 0, -1); // Drop everything: the second pass regenerates what it meets
+        }
+        closeMazeChunkWorld(&world);
+    }
+
+    qsort(latencies, runs, sizeof(double), compareDoubles);
+    result->runs = runs;
+    result->totalSeconds = total;
+    result->p50 = percentile(latencies, runs, 50.0);
+    result->p90 = percentile(latencies, runs, 90.0);
+    result->p99 = percentile(latencies, runs, 99.0);
+    result->maxMs = latencies[runs - 1];
+    free(latencies);
+    free(hashes);
+}
+
+/*
+ * Runs one size/algorithm configuration in a forked child so that its peak RSS
+ * is measured in isolation and a crash (e.g. the OOM killer or a failed allocation
+ * on huge sizes, or a failed --world check) is reported instead of aborting the sweep.
+ * Returns 1 on success, 0 if the child failed.
+ */
+int benchConfiguration(int rows, int cols, int algorithm, unsigned int firstSeed, int seeds, BenchTiling tiling, int hybridPercent, int worldSteps, int csv) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        perror("Error creating result pipe");
+        exit(EXIT_FAILURE);
+    }
+    fflush(stdout); // Don't duplicate buffered output into the child
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        perror("Error forking benchmark child");
+        exit(EXIT_FAILURE);
+    }
+    if (pid == 0) { // --- Child: run and send results back ---
+        close(fds[0]);
+        BenchResult result;
+        if (worldSteps > 0) runWorldConfiguration(algorithm, firstSeed, seeds, worldSteps, &result);
+        else runConfiguration(rows, cols, algorithm, firstSeed, seeds, tiling, hybridPercent, &result);
+        ssize_t written = write(fds[1], &result, sizeof(result));
+        _exit(written == (ssize_t)sizeof(result) ? 0 : 1);
+    }
+
+    // --- Parent: collect results and child resource usage ---
+    close(fds[1]);
+    BenchResult result;
+    ssize_t got = read(fds[0], &result, sizeof(result));
+    close(fds[0]);
+
+    int status = 0;
+    struct rusage usage;
+    memset(&usage, 0, sizeof(usage));
+    wait4(pid, &status, 0, &usage);
+    long peakKib = usage.ru_maxrss; // Kilobytes on Linux
+
+    char algoName[64];
+    if (tiling.tileCells > 0) {
+        snprintf(algoName, sizeof(algoName), "%s (tiles %d, %d threads)", getAlgorithmName(algorithm), tiling.tileCells, tiling.threads);
+    } else if (worldSteps > 0) {
+        snprintf(algoName, sizeof(algoName), "%s (world, %d-chunk cache)", getAlgorithmName(algorithm), BENCH_WORLD_CACHE);
+    } else if (hybridPercent >= 0) {
+        // Only 0 and 100 percent are exactly uniform; say so next to the timings
+        snprintf(algoName, sizeof(algoName), "Wilson's + %d%% Aldous-Broder%s", hybridPercent,
+                 (hybridPercent > 0 && hybridPercent < 100) ? " (biased)" : "");
+    } else {
+        snprintf(algoName, sizeof(algoName), "%s", getAlgorithmName(algorithm));
+    }
+    char sizeText[32];
+    if (rows == cols) snprintf(sizeText, sizeof(sizeText), "%d", cols);
+    else snprintf(sizeText, sizeof(sizeText), "%dx%d", cols, rows);
+    if (got != (ssize_t)sizeof(result) || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        char reason[32];
+        if (WIFSIGNALED(status)) snprintf(reason, sizeof(reason), "signal %d", WTERMSIG(status));
+        else snprintf(reason, sizeof(reason), "failed");
+        if (csv) printf("%s,\"%s\",%d,,,,,,%ld,%s\n", sizeText, algoName, seeds, peakKib, reason);
+        else printf("%-11s %-*s %6d   crashed (%s)\n", sizeText, BENCH_NAME_WIDTH(tiling.tileCells > 0 || worldSteps > 0), algoName, seeds, reason);
+        return 0;
+    }
+
+    double cellsPerSecond = (result.totalSeconds > 0.0)
+        ? ((double)rows * cols * result.runs) / result.totalSeconds : 0.0;
+    if (csv) {
+        printf("%s,\"%s\",%d,%.0f,%.3f,%.3f,%.3f,%.3f,%ld,ok\n",
+               sizeText, algoName, result.runs, cellsPerSecond, result.p50, result.p90, result.p99, result.maxMs, peakKib);
+    } else {
+        printf("%-11s %-*s %6d %14.0f %9.3f %9.3f %9.3f %9.3f %12ld\n",
+               sizeText, BENCH_NAME_WIDTH(tiling.tileCells > 0 || worldSteps > 0), algoName, result.runs, cellsPerSecond, result.p50, result.p90, result.p99, result.maxMs, peakKib);
+    }
+    return 1;
+}
+
+// Prints command line help to stderr.
+void printUsage(const char* program) {
+    fprintf(stderr, "Usage: %s [--sizes 21,51,401x201] [--algorithms 1,2,3,4,5,6,7,8,9] [--seeds N] [--first-seed S] [--tile N [-j N]] [--hybrid PCT] [--world N] [--csv]\n", program);
+    fprintf(stderr, "  --sizes       Comma separated maze sizes, N or WIDTHxHEIGHT (odd; even sizes are rounded up)\n");
+    fprintf(stderr, "  --algorithms  1=Prim's 2=Kruskal's 3=Wilson's 4=Recursive Backtracker 5=Recursive Backtracker (Alternative) 6=Eller's 7=Binary Tree 8=Sidewinder 9=Recursive Division\n");
+    fprintf(stderr, "  --seeds       Mazes generated per size/algorithm (default %d)\n", BENCH_DEFAULT_SEEDS);
+    fprintf(stderr, "  --first-seed  First seed of the sweep; seeds are consecutive (default 1)\n");
+    fprintf(stderr, "  --tile        Generate in parallel tiles of N x N lattice cells (see maze-tiled.h)\n");
+    fprintf(stderr, "  -j, --threads Threads for --tile (default: one per CPU)\n");
+    fprintf(stderr, "  --hybrid      Also time Wilson's (3) with an Aldous-Broder walk over PCT%% of the cells first\n");
+    fprintf(stderr, "                (faster, but not exactly uniform for 0 < PCT < 100; try %d)\n", MAZE_WILSON_ALDOUS_BRODER_PERCENT);
+    fprintf(stderr, "  --world       Instead of sizes: walk N chunks of an endless world (maze-chunks.h), then check\n");
+    fprintf(stderr, "                that every chunk regenerates identically after eviction\n");
+    fprintf(stderr, "  --csv         Machine readable output\n");
+}
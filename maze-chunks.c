@@ -0,0 +1,222 @@
+// C-MAZE CHUNKS - Endless maze world generated lazily in chunks
+// See maze-chunks.h for the layout of the world and its chunks.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>   // For memcpy() and memset()
+
+#include "maze-chunks.h"
+
+// --- Hash Salts ---
+#define CHUNK_SALT_BUCKET 0     // Cache bucket of a chunk
+#define CHUNK_SALT_NORTH 1      // Opening in the chunk's north seam
+#define CHUNK_SALT_WEST 2       // Opening in the chunk's west seam
+#define CHUNK_SALT_RNG 3        // Generator state (CHUNK_SALT_RNG .. + 3)
+
+// === CHUNK HASHING FUNCTIONS ===
+
+// splitmix64 finalizer: spreads every input bit over the whole word.
+static inline uint64_t mixMazeChunkKey(uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+/*
+ * 64-bit hash of (seed, chunkX, chunkY, salt). Everything random about a chunk comes
+ * from here, which is what makes chunks regenerate identically after eviction.
+ */
+static uint64_t hashMazeChunk(unsigned int seed, long long chunkX, long long chunkY, uint64_t salt) {
+    uint64_t h = mixMazeChunkKey((uint64_t)seed + salt * 0x9E3779B97F4A7C15ULL);
+    h = mixMazeChunkKey(h ^ (uint64_t)chunkX);
+    return mixMazeChunkKey(h ^ ((uint64_t)chunkY * 0xD6E8FEB86659FD93ULL));
+}
+
+// Chunk holding world row/column 'v' (floor division, also for negative coordinates).
+static inline long long getMazeChunkCoord(long long v) {
+    return v < 0 ? (v + 1) / MAZE_CHUNK_SIZE - 1 : v / MAZE_CHUNK_SIZE;
+}
+
+// === CHUNK GENERATION FUNCTIONS ===
+
+/*
+ * Generates chunk (chunkX, chunkY) into 'chunk'. The lattice part is an ordinary maze of
+ * MAZE_CHUNK_CELLS x MAZE_CHUNK_CELLS cells made on the world's scratch context; its top
+ * row and left column are the outer walls, which become the north and west seams with
+ * one hash-chosen opening each. The south and east walls belong to the neighbours.
+ */
+static void generateMazeChunk(MazeChunkWorld *world, MazeChunk *chunk, long long chunkX, long long chunkY) {
+    MazeContext *ctx = &world->ctx;
+    if (!ctx->grid.cells) {
+        allocateMazeGrid(&ctx->grid, MAZE_CHUNK_SIZE + 1, MAZE_CHUNK_SIZE + 1);
+    } else {
+        fillMazeGrid(&ctx->grid, WALL_CHAR);
+    }
+
+    // --- Full 256-bit generator state from the chunk's hash (never all zero) ---
+    for (int i = 0; i < 4; i++) ctx->rng.s[i] = hashMazeChunk(world->seed, chunkX, chunkY, CHUNK_SALT_RNG + (uint64_t)i);
+    ctx->rng.s[0] |= 1;
+    generateMaze(ctx, world->algorithm, 1, 1);
+    MAZE_CELL(&ctx->grid, 1, 1) = PATH_CHAR;
+
+    for (int x = 0; x < MAZE_CHUNK_SIZE; x++) {
+        memcpy(&MAZE_CHUNK_CELL(chunk, x, 0), &MAZE_CELL(&ctx->grid, x, 0), MAZE_CHUNK_SIZE);
+    }
+
+    // --- Seam openings ---
+    int north = (int)(hashMazeChunk(world->seed, chunkX, chunkY, CHUNK_SALT_NORTH) % MAZE_CHUNK_CELLS);
+    int west = (int)(hashMazeChunk(world->seed, chunkX, chunkY, CHUNK_SALT_WEST) % MAZE_CHUNK_CELLS);
+    MAZE_CHUNK_CELL(chunk, 0, 2 * north + 1) = PATH_CHAR;
+    MAZE_CHUNK_CELL(chunk, 2 * west + 1, 0) = PATH_CHAR;
+
+    chunk->chunkX = chunkX;
+    chunk->chunkY = chunkY;
+    world->generated++;
+}
+
+// === CHUNK CACHE FUNCTIONS ===
+
+/*
+ * Prepares an empty world for 'seed'. Chunks are made with 'algorithm', which must
+ * connect every cell; at most 'cacheChunks' chunks (values < 1 mean
+ * MAZE_CHUNK_DEFAULT_CACHE) are kept, about 4 KB each. Keep it above the number of
+ * chunks one frame touches, or they will be regenerated every frame.
+ * Returns 1 on success, 0 on error (reported).
+ */
+int openMazeChunkWorld(MazeChunkWorld *world, unsigned int seed, int algorithm, int cacheChunks) {
+    memset(world, 0, sizeof(*world));
+    if (!algorithmGuaranteesConnectivity(algorithm)) {
+        fprintf(stderr, "Error: Chunked worlds need an algorithm that connects every cell.\n");
+        return 0;
+    }
+    if (cacheChunks < 1) cacheChunks = MAZE_CHUNK_DEFAULT_CACHE;
+
+    int buckets = 1;
+    while (buckets < 2 * cacheChunks) buckets <<= 1;
+    world->chunks = (MazeChunk *)malloc((size_t)cacheChunks * sizeof(MazeChunk));
+    world->buckets = (int *)malloc((size_t)buckets * sizeof(int));
+    if (!world->chunks || !world->buckets) {
+        perror("Error allocating chunk cache");
+        free(world->chunks); free(world->buckets);
+        world->chunks = NULL; world->buckets = NULL;
+        return 0;
+    }
+
+    world->seed = seed;
+    world->algorithm = algorithm;
+    world->capacity = cacheChunks;
+    world->bucketMask = buckets - 1;
+    world->newest = world->oldest = -1;
+    for (int i = 0; i < buckets; i++) world->buckets[i] = -1;
+    for (int i = 0; i < cacheChunks; i++) world->chunks[i].hashNext = (i + 1 < cacheChunks) ? i + 1 : -1;
+    world->freeSlots = 0;
+    return 1;
+}
+
+// Releases everything allocated by openMazeChunkWorld() and the generated chunks.
+void closeMazeChunkWorld(MazeChunkWorld *world) {
+    free(world->chunks);
+    free(world->buckets);
+    freeMazeContext(&world->ctx);
+    memset(world, 0, sizeof(*world));
+}
+
+// Hash bucket of chunk (chunkX, chunkY).
+static inline int getMazeChunkBucket(const MazeChunkWorld *world, long long chunkX, long long chunkY) {
+    return (int)(hashMazeChunk(0, chunkX, chunkY, CHUNK_SALT_BUCKET) & (uint64_t)world->bucketMask);
+}
+
+// Removes slot 'slot' from the LRU list.
+static void unlinkMazeChunkAge(MazeChunkWorld *world, int slot) {
+    MazeChunk *chunk = &world->chunks[slot];
+    if (chunk->newer >= 0) world->chunks[chunk->newer].older = chunk->older; else world->newest = chunk->older;
+    if (chunk->older >= 0) world->chunks[chunk->older].newer = chunk->newer; else world->oldest = chunk->newer;
+}
+
+// Puts slot 'slot' at the newest end of the LRU list.
+static void pushMazeChunkAge(MazeChunkWorld *world, int slot) {
+    MazeChunk *chunk = &world->chunks[slot];
+    chunk->newer = -1;
+    chunk->older = world->newest;
+    if (world->newest >= 0) world->chunks[world->newest].newer = slot; else world->oldest = slot;
+    world->newest = slot;
+}
+
+// Drops slot 'slot' from the cache (hash chain and LRU list) and returns it to the free list.
+static void evictMazeChunkSlot(MazeChunkWorld *world, int slot) {
+    MazeChunk *chunk = &world->chunks[slot];
+    int *link = &world->buckets[getMazeChunkBucket(world, chunk->chunkX, chunk->chunkY)];
+    while (*link != slot) link = &world->chunks[*link].hashNext;
+    *link = chunk->hashNext;
+    unlinkMazeChunkAge(world, slot);
+
+    chunk->hashNext = world->freeSlots;
+    world->freeSlots = slot;
+    world->count--;
+}
+
+/*
+ * Returns chunk (chunkX, chunkY), generating it on first access. When the cache is full
+ * the least recently used chunk is evicted to make room. The pointer stays valid until
+ * the next getMazeChunk(), getMazeWorldCell() or evictFarMazeChunks() call.
+ */
+const MazeChunk* getMazeChunk(MazeChunkWorld *world, long long chunkX, long long chunkY) {
+    // --- Fast path: the player keeps asking for the same chunk ---
+    if (world->newest >= 0) {
+        MazeChunk *newest = &world->chunks[world->newest];
+        if (newest->chunkX == chunkX && newest->chunkY == chunkY) return newest;
+    }
+
+    int bucket = getMazeChunkBucket(world, chunkX, chunkY);
+    for (int slot = world->buckets[bucket]; slot >= 0; slot = world->chunks[slot].hashNext) {
+        MazeChunk *chunk = &world->chunks[slot];
+        if (chunk->chunkX == chunkX && chunk->chunkY == chunkY) {
+            unlinkMazeChunkAge(world, slot);
+            pushMazeChunkAge(world, slot);
+            return chunk;
+        }
+    }
+
+    // --- Miss: take a free slot, or the least recently used one ---
+    if (world->freeSlots < 0) evictMazeChunkSlot(world, world->oldest);
+    int slot = world->freeSlots;
+    MazeChunk *chunk = &world->chunks[slot];
+    world->freeSlots = chunk->hashNext;
+    world->count++;
+
+    generateMazeChunk(world, chunk, chunkX, chunkY);
+    chunk->hashNext = world->buckets[bucket];
+    world->buckets[bucket] = slot;
+    pushMazeChunkAge(world, slot);
+    return chunk;
+}
+
+// WALL_CHAR or PATH_CHAR at world cell (x, y); generates its chunk if needed.
+char getMazeWorldCell(MazeChunkWorld *world, long long x, long long y) {
+    long long chunkX = getMazeChunkCoord(x);
+    long long chunkY = getMazeChunkCoord(y);
+    const MazeChunk *chunk = getMazeChunk(world, chunkX, chunkY);
+    return MAZE_CHUNK_CELL(chunk, x - chunkX * MAZE_CHUNK_SIZE, y - chunkY * MAZE_CHUNK_SIZE);
+}
+
+/*
+ * Evicts every cached chunk more than 'radius' chunks away (in rows or columns) from
+ * the chunk holding world cell (x, y), usually the player's. Chunks are regenerated on
+ * demand, so this only trades memory for time. Returns the number of chunks evicted.
+ */
+int evictFarMazeChunks(MazeChunkWorld *world, long long x, long long y, long long radius) {
+    long long centerX = getMazeChunkCoord(x);
+    long long centerY = getMazeChunkCoord(y);
+    int evicted = 0;
+    for (int slot = world->oldest; slot >= 0;) {
+        MazeChunk *chunk = &world->chunks[slot];
+        int newer = chunk->newer;
+        long long dx = chunk->chunkX - centerX;
+        long long dy = chunk->chunkY - centerY;
+        if (dx < -radius || dx > radius || dy < -radius || dy > radius) {
+            evictMazeChunkSlot(world, slot);
+            evicted++;
+        }
+        slot = newer;
+    }
+    return evicted;
+}
@@ -0,0 +1,61 @@
+// C-MAZE CHUNKS - Endless maze world generated lazily in chunks
+// Note: Plain C99 like the engine; no threads, console or OS calls.
+//
+// The world is an unbounded grid (x = row, y = column, both may be negative) cut into
+// square chunks of MAZE_CHUNK_SIZE x MAZE_CHUNK_SIZE grid cells. Chunk (cx, cy) covers
+// rows cx * MAZE_CHUNK_SIZE .. + MAZE_CHUNK_SIZE - 1 and the matching columns. Its first
+// row and column are the seams it shares with its north and west neighbours; the rest
+// is a maze of MAZE_CHUNK_CELLS x MAZE_CHUNK_CELLS lattice cells made by one of the
+// engine's algorithms.
+//
+// Everything in a chunk is a pure function of (seed, cx, cy): the generator's random
+// state and the one opening in each seam come from a hash of those values, so a chunk
+// evicted from the cache regenerates identically, and the seam a chunk owns always
+// matches what its neighbour expects. Every chunk is connected inside and every seam
+// has an opening, so the whole world is connected (with loops at chunk scale).
+// Chunks are generated on first access and kept in a fixed-size LRU cache, so memory
+// stays bounded however far the player travels.
+#ifndef MAZE_CHUNKS_H
+#define MAZE_CHUNKS_H
+
+#include "maze-engine.h"
+
+// --- Chunk Settings ---
+#define MAZE_CHUNK_CELLS 32                         // Lattice cells per chunk side
+#define MAZE_CHUNK_SIZE (2 * MAZE_CHUNK_CELLS)      // Grid cells per chunk side (seam included)
+#define MAZE_CHUNK_DEFAULT_CACHE 64                 // Chunks kept in memory by default
+
+// --- Structs ---
+// One generated chunk, also a node of the cache's LRU list and hash chains
+typedef struct {
+    long long chunkX, chunkY;
+    char cells[MAZE_CHUNK_SIZE * MAZE_CHUNK_SIZE];  // Row-major WALL_CHAR / PATH_CHAR
+    int newer, older;   // LRU neighbours (slot indices, -1 at the ends)
+    int hashNext;       // Next slot in the same hash bucket or free list (-1 at the end)
+} MazeChunk;
+
+// Lazily generated world plus its chunk cache (see openMazeChunkWorld)
+typedef struct {
+    unsigned int seed;
+    int algorithm;          // Engine algorithm used inside chunks
+    MazeChunk *chunks;      // 'capacity' cache slots
+    int capacity, count;    // Slots allocated / in use
+    int *buckets;           // Hash bucket heads (slot index, -1 = empty)
+    int bucketMask;         // Bucket count - 1 (power of two)
+    int newest, oldest;     // LRU list ends (-1 when empty)
+    int freeSlots;          // Unused slots, chained through hashNext (-1 when full)
+    MazeContext ctx;        // Generation scratch, reused for every chunk
+    long long generated;    // Chunks generated so far (regenerations included)
+} MazeChunkWorld;
+
+// Reads one cell of a cached chunk; (x, y) are relative to the chunk (0 .. MAZE_CHUNK_SIZE - 1)
+#define MAZE_CHUNK_CELL(chunk, x, y) ((chunk)->cells[(size_t)(x) * MAZE_CHUNK_SIZE + (size_t)(y)])
+
+// --- Function Prototypes ---
+int openMazeChunkWorld(MazeChunkWorld *world, unsigned int seed, int algorithm, int cacheChunks); // Sets up an empty cache
+void closeMazeChunkWorld(MazeChunkWorld *world);    // Frees the cache and scratch memory
+const MazeChunk* getMazeChunk(MazeChunkWorld *world, long long chunkX, long long chunkY); // Cached or freshly generated chunk
+char getMazeWorldCell(MazeChunkWorld *world, long long x, long long y);  // WALL_CHAR or PATH_CHAR at a world cell
+int evictFarMazeChunks(MazeChunkWorld *world, long long x, long long y, long long radius); // Drops chunks farther than 'radius' chunks
+
+#endif // MAZE_CHUNKS_H
@@ -0,0 +1,63 @@
+// C-MAZE CLI - Command line helpers shared by the headless tools
+// See maze-cli.h.
+#if !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L // For clock_gettime()
+#endif
+
+#include <stdlib.h>   // For strtol()
+#include <time.h>     // For clock_gettime()
+
+#include "maze-cli.h"
+
+// Returns a monotonic timestamp in seconds.
+double getMazeCliSeconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/*
+ * Parses a comma separated list of integers ("21,51,101") into 'out'.
+ * Returns the number of values read, or -1 on malformed input.
+ */
+int parseMazeIntList(const char *text, int *out, int maxCount) {
+    int count = 0;
+    const char *p = text;
+    while (*p != '\0') {
+        char *endPtr;
+        long value = strtol(p, &endPtr, 10);
+        if (endPtr == p || count >= maxCount) return -1;
+        out[count++] = (int)value;
+        p = endPtr;
+        if (*p == ',') p++;
+        else if (*p != '\0') return -1;
+    }
+    return count;
+}
+
+/*
+ * Parses a comma separated list of sizes, each "N" (square) or "WxH".
+ * Returns the number of sizes read, or -1 on malformed input.
+ */
+int parseMazeSizeList(const char *text, int *cols, int *rows, int maxCount) {
+    int count = 0;
+    const char *p = text;
+    while (*p != '\0') {
+        char *endPtr;
+        long width = strtol(p, &endPtr, 10);
+        if (endPtr == p || count >= maxCount) return -1;
+        long height = width;
+        if (*endPtr == 'x' || *endPtr == 'X') {
+            p = endPtr + 1;
+            height = strtol(p, &endPtr, 10);
+            if (endPtr == p) return -1;
+        }
+        cols[count] = (int)width;
+        rows[count] = (int)height;
+        count++;
+        p = endPtr;
+        if (*p == ',') p++;
+        else if (*p != '\0') return -1;
+    }
+    return count;
+}
@@ -0,0 +1,12 @@
+// C-MAZE CLI - Command line helpers shared by the headless tools
+// Note: Plain C99 plus clock_gettime() (POSIX); used by c-maze-bench and c-maze-batch,
+// not by the game.
+#ifndef MAZE_CLI_H
+#define MAZE_CLI_H
+
+// --- Function Prototypes ---
+double getMazeCliSeconds();  // Monotonic clock in seconds
+int parseMazeIntList(const char *text, int *out, int maxCount);  // Parses "a,b,c" into an int array; -1 if malformed
+int parseMazeSizeList(const char *text, int *cols, int *rows, int maxCount);    // Parses "21,41x21" into width/height arrays; -1 if malformed
+
+#endif // MAZE_CLI_H
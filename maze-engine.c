@@ -0,0 +1,1268 @@
+// C-MAZE ENGINE - Maze storage and generation algorithms
+// Shared by the game (c-maze-v2.c) and the command line tools (c-maze-bench.c).
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L // For posix_memalign()
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>   // For memset(), memcpy()
+#ifdef _WIN32
+#include <malloc.h>   // For _aligned_malloc(), _aligned_free()
+#endif
+
+#include "maze-engine.h"
+
+// === MAZE STORAGE FUNCTIONS ===
+
+// Allocates 'size' bytes aligned to MAZE_GRID_ALIGNMENT (NULL on failure).
+static void* allocAligned(size_t size) {
+#ifdef _WIN32
+    return _aligned_malloc(size, MAZE_GRID_ALIGNMENT);
+#else
+    void* block = NULL;
+    if (posix_memalign(&block, MAZE_GRID_ALIGNMENT, size) != 0) return NULL;
+    return block;
+#endif
+}
+
+static void freeAligned(void* block) {
+#ifdef _WIN32
+    _aligned_free(block);
+#else
+    free(block);
+#endif
+}
+
+/*
+ * Allocates a rows x cols grid as one contiguous, cache-line aligned block and
+ * fills every cell with walls. Rows are padded to a multiple of MAZE_GRID_ALIGNMENT
+ * so each row starts on its own cache line.
+ * Exits the program if memory cannot be allocated.
+ */
+void allocateMazeGrid(MazeGrid *grid, int rows, int cols) {
+    grid->rows = rows;
+    grid->cols = cols;
+    grid->stride = ((size_t)cols + MAZE_GRID_ALIGNMENT - 1) & ~(size_t)(MAZE_GRID_ALIGNMENT - 1);
+    grid->cells = (char *)allocAligned((size_t)rows * grid->stride);
+    if (!grid->cells) {
+        perror("FATAL ERROR: Failed to allocate memory for maze grid");
+        exit(EXIT_FAILURE);
+    }
+    fillMazeGrid(grid, WALL_CHAR); // Initialize all cells as walls initially
+}
+
+/*
+ * Frees the grid memory. Safe to call on an already freed grid;
+ * cells is set to NULL afterwards.
+ */
+void freeMazeGrid(MazeGrid *grid) {
+    if (grid->cells != NULL) {
+        freeAligned(grid->cells);
+        grid->cells = NULL;
+    }
+}
+
+// Sets every cell of the grid (including row padding) to 'value'.
+void fillMazeGrid(MazeGrid *grid, char value) {
+    memset(grid->cells, value, (size_t)grid->rows * grid->stride);
+}
+
+// Sets the dimensions of wall planes for a rows x cols grid (planes are left untouched).
+static void setMazeWallsSize(MazeWalls *walls, int rows, int cols) {
+    walls->rows = rows;
+    walls->cols = cols;
+    walls->cellRows = (rows - 1) / 2;
+    walls->cellCols = (cols - 1) / 2;
+    walls->wordsPerRow = ((size_t)walls->cellCols + 63) / 64;
+}
+
+/*
+ * Allocates zeroed (all walls closed) east/south planes for a rows x cols grid.
+ * Returns 1 on success, 0 if memory could not be allocated.
+ */
+int allocateMazeWalls(MazeWalls *walls, int rows, int cols) {
+    setMazeWallsSize(walls, rows, cols);
+    size_t planeWords = walls->wordsPerRow * (size_t)walls->cellRows;
+    walls->east = (uint64_t *)calloc(planeWords ? planeWords : 1, sizeof(uint64_t));
+    walls->south = (uint64_t *)calloc(planeWords ? planeWords : 1, sizeof(uint64_t));
+    if (!walls->east || !walls->south) {
+        perror("Error allocating wall planes");
+        freeMazeWalls(walls);
+        return 0;
+    }
+    return 1;
+}
+
+/*
+ * Packs the wall layout of a generated grid into two bit planes over the odd-cell lattice.
+ * Bit (r, c) of 'east' is set when cell (2r+1, 2c+1) opens to (2r+1, 2c+3), bit (r, c)
+ * of 'south' when it opens to (2r+3, 2c+1). Lattice cells themselves are taken as open and
+ * even/even cells as walls, which holds for every generator, so a board costs 2 bits per
+ * lattice cell (half a bit per grid cell) instead of one byte per grid cell.
+ * Exit and bonus markers are overlays and are not stored.
+ * Returns 1 on success, 0 if memory could not be allocated.
+ */
+int packMazeWalls(const MazeGrid *grid, MazeWalls *walls) {
+    if (!allocateMazeWalls(walls, grid->rows, grid->cols)) return 0;
+    packMazeWallRows(grid, walls->east, walls->south, walls->wordsPerRow);
+    return 1;
+}
+
+/*
+ * Writes the east/south wall planes of 'grid' into caller-owned, zeroed buffers of
+ * (rows - 1) / 2 rows of 'wordsPerRow' words each. Lets writers pack straight into
+ * an output buffer without a temporary MazeWalls allocation.
+ */
+void packMazeWallRows(const MazeGrid *grid, uint64_t *east, uint64_t *south, size_t wordsPerRow) {
+    int cellRows = (grid->rows - 1) / 2;
+    int cellCols = (grid->cols - 1) / 2;
+    for (int r = 0; r < cellRows; r++) {
+        // Row 2r+1 holds the cells and their east walls, row 2r+2 their south walls
+        const char *cellRow = &MAZE_CELL(grid, 2 * r + 1, 0);
+        const char *belowRow = &MAZE_CELL(grid, 2 * r + 2, 0);
+        uint64_t *eastRow = east + (size_t)r * wordsPerRow;
+        uint64_t *southRow = south + (size_t)r * wordsPerRow;
+        for (int c = 0; c < cellCols; c++) {
+            uint64_t bit = (uint64_t)1 << (c & 63);
+            if (cellRow[2 * c + 2] != WALL_CHAR) eastRow[c >> 6] |= bit;
+            if (belowRow[2 * c + 1] != WALL_CHAR) southRow[c >> 6] |= bit;
+        }
+    }
+}
+
+/*
+ * Rebuilds a character grid from packed wall planes. Allocates 'grid' with the
+ * original dimensions; lattice cells and open walls become PATH_CHAR.
+ */
+void unpackMazeWalls(const MazeWalls *walls, MazeGrid *grid) {
+    allocateMazeGrid(grid, walls->rows, walls->cols);
+    unpackMazeWallRows(walls, grid);
+}
+
+// Opens the lattice cells and open walls of 'walls' in an existing all-wall grid of the same size.
+void unpackMazeWallRows(const MazeWalls *walls, MazeGrid *grid) {
+    for (int r = 0; r < walls->cellRows; r++) {
+        char *cellRow = &MAZE_CELL(grid, 2 * r + 1, 0);
+        char *belowRow = &MAZE_CELL(grid, 2 * r + 2, 0);
+        for (int c = 0; c < walls->cellCols; c++) {
+            cellRow[2 * c + 1] = PATH_CHAR;
+            if (MAZE_WALL_OPEN(walls->east, walls->wordsPerRow, r, c)) cellRow[2 * c + 2] = PATH_CHAR;
+            if (MAZE_WALL_OPEN(walls->south, walls->wordsPerRow, r, c)) belowRow[2 * c + 1] = PATH_CHAR;
+        }
+    }
+}
+
+/*
+ * Returns 1 if grid cell (x, y) is open in the packed layout, reading the planes in place
+ * (same result as MAZE_CELL on the unpacked grid being != WALL_CHAR, ignoring overlays).
+ */
+int mazeWallsCellOpen(const MazeWalls *walls, int x, int y) {
+    if (x <= 0 || y <= 0 || x >= walls->rows - 1 || y >= walls->cols - 1) return 0; // Border
+    if (x % 2 == 1 && y % 2 == 1) return 1; // Lattice cell
+    if (x % 2 == 1) return (int)MAZE_WALL_OPEN(walls->east, walls->wordsPerRow, x / 2, y / 2 - 1);  // Between two cells of a row
+    if (y % 2 == 1) return (int)MAZE_WALL_OPEN(walls->south, walls->wordsPerRow, x / 2 - 1, y / 2); // Between two cells of a column
+    return 0; // Even/even corners are always walls
+}
+
+// Frees both wall planes. Safe to call on partially allocated planes.
+void freeMazeWalls(MazeWalls *walls) {
+    free(walls->east);
+    free(walls->south);
+    walls->east = NULL;
+    walls->south = NULL;
+}
+
+/*
+ * Empties the arena and makes sure it can hold at least 'capacity' bytes.
+ * Memory is kept between uses, so repeated runs of the same size allocate nothing.
+ * Returns 1 on success, 0 if the arena could not grow (it is then left empty).
+ */
+int mazeArenaReset(MazeArena *arena, size_t capacity) {
+    arena->used = 0;
+    if (capacity > arena->capacity) {
+        unsigned char *grown = (unsigned char *)realloc(arena->base, capacity);
+        if (!grown) return 0;
+        arena->base = grown;
+        arena->capacity = capacity;
+    }
+    return 1;
+}
+
+/*
+ * Hands out 'size' bytes from the arena (8-byte aligned).
+ * Returns NULL if the request does not fit in the reserved capacity.
+ */
+void* mazeArenaAlloc(MazeArena *arena, size_t size) {
+    size_t offset = (arena->used + 7) & ~(size_t)7;
+    if (offset > arena->capacity || size > arena->capacity - offset) return NULL;
+    arena->used = offset + size;
+    return arena->base + offset;
+}
+
+// Releases the arena's memory.
+void freeMazeArena(MazeArena *arena) {
+    free(arena->base);
+    arena->base = NULL;
+    arena->used = arena->capacity = 0;
+}
+
+// --- Generation Context ---
+
+/*
+ * Seeds the generator; the same seed always yields the same sequence on every platform.
+ * The 256-bit state is expanded from the seed with splitmix64, so nearby seeds give
+ * unrelated sequences and the state is never all zero.
+ */
+void mazeRngSeed(MazeRng *rng, unsigned int seed) {
+    mazeRngSeedStream(rng, seed, 0);
+}
+
+/*
+ * Seeds sub-sequence 'stream' (below 2^32) of 'seed', for jobs that split one board
+ * into independently generated parts. Every (seed, stream) pair has its own sequence;
+ * stream 0 is the one mazeRngSeed() gives.
+ */
+void mazeRngSeedStream(MazeRng *rng, unsigned int seed, uint64_t stream) {
+    uint64_t x = (stream << 32) ^ (uint64_t)seed;
+    for (int i = 0; i < 4; i++) {
+        uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        rng->s[i] = z ^ (z >> 31);
+    }
+}
+
+/*
+ * Frees everything a context owns (grid, scratch arena, BFS workspace) and leaves it
+ * zeroed, ready for reuse.
+ */
+void freeMazeContext(MazeContext *ctx) {
+    freeMazeGrid(&ctx->grid);
+    freeMazeArena(&ctx->arena);
+    freeMazeBfsWorkspace(&ctx->bfs);
+}
+
+// === MAZE VALIDATION FUNCTIONS ===
+
+/*
+ * Makes sure the workspace can search a grid of 'cells' cells.
+ * Buffers only ever grow, so validating boards of the same size allocates nothing.
+ * Returns 1 on success, 0 if memory could not be allocated.
+ */
+static int reserveBfsWorkspace(MazeBfsWorkspace *ws, size_t cells) {
+    if (cells <= ws->capacity) return 1;
+
+    size_t words = (cells + 63) / 64;
+    uint32_t *queue = (uint32_t *)realloc(ws->queue, cells * sizeof(uint32_t));
+    if (!queue) return 0;
+    ws->queue = queue;
+    uint64_t *bits = (uint64_t *)realloc(ws->visitedBits, words * sizeof(uint64_t));
+    if (!bits) return 0;
+    ws->visitedBits = bits;
+    // Fresh stamps of 0 never match a live generation, so new words read as unvisited
+    uint32_t *stamps = (uint32_t *)calloc(words, sizeof(uint32_t));
+    if (!stamps) return 0;
+    free(ws->wordGeneration);
+    ws->wordGeneration = stamps;
+    ws->capacity = cells;
+    ws->generation = 0;
+    return 1;
+}
+
+/*
+ * Tests and sets the visited bit of a cell. A 64-cell word whose stamp is older than the
+ * current generation is treated as all-unvisited and cleared on first touch, so starting
+ * a new search never has to clear the whole bitmap.
+ * Returns 1 if the cell was already visited in this search.
+ */
+static int testAndSetVisited(MazeBfsWorkspace *ws, uint32_t cell) {
+    size_t word = cell >> 6;
+    uint64_t bit = (uint64_t)1 << (cell & 63);
+    if (ws->wordGeneration[word] != ws->generation) {
+        ws->wordGeneration[word] = ws->generation;
+        ws->visitedBits[word] = bit;
+        return 0;
+    }
+    if (ws->visitedBits[word] & bit) return 1;
+    ws->visitedBits[word] |= bit;
+    return 0;
+}
+
+/*
+ * Checks if (targetX, targetY) can be reached from (startX, startY) through non-wall
+ * cells using Breadth-First Search (BFS). The queue holds packed 32-bit cell indices
+ * (x * cols + y) and visited cells live in a bitmap, both owned by 'ws' and reused
+ * across calls, so repeated validations are allocation free.
+ * Returns 1 if reachable, 0 if not (or if the workspace could not be allocated).
+ */
+int isCellReachable(const MazeGrid *grid, MazeBfsWorkspace *ws, int startX, int startY, int targetX, int targetY) {
+    if (startX == targetX && startY == targetY) return 1; // Edge case: start is target
+    if (startX < 0 || startX >= grid->rows || startY < 0 || startY >= grid->cols || MAZE_CELL(grid, startX, startY) == WALL_CHAR) {
+        return 0; // Start position is invalid (a wall?), target unreachable by definition
+    }
+
+    size_t cells = (size_t)grid->rows * (size_t)grid->cols;
+    if (cells > UINT32_MAX || !reserveBfsWorkspace(ws, cells)) {
+        perror("Error allocating BFS workspace");
+        return 0;
+    }
+
+    // --- Start a new search generation ---
+    if (++ws->generation == 0) { // Stamp counter wrapped: forget all old stamps once
+        memset(ws->wordGeneration, 0, ((ws->capacity + 63) / 64) * sizeof(uint32_t));
+        ws->generation = 1;
+    }
+
+    uint32_t cols = (uint32_t)grid->cols;
+    uint32_t target = (uint32_t)targetX * cols + (uint32_t)targetY;
+    size_t front = 0, rear = 0;
+    ws->queue[rear++] = (uint32_t)startX * cols + (uint32_t)startY;
+    testAndSetVisited(ws, ws->queue[0]);
+
+    // --- Perform BFS ---
+    while (front < rear) { // While queue is not empty
+        uint32_t cell = ws->queue[front++];
+        if (cell == target) return 1; // Target found!
+
+        int x = (int)(cell / cols);
+        int y = (int)(cell - (uint32_t)x * cols);
+        const char *row = &MAZE_CELL(grid, x, 0);
+
+        // Explore neighbors (Up, Down, Left, Right), skipping walls and visited cells
+        if (x > 0 && (row - grid->stride)[y] != WALL_CHAR && !testAndSetVisited(ws, cell - cols)) ws->queue[rear++] = cell - cols;
+        if (x < grid->rows - 1 && (row + grid->stride)[y] != WALL_CHAR && !testAndSetVisited(ws, cell + cols)) ws->queue[rear++] = cell + cols;
+        if (y > 0 && row[y - 1] != WALL_CHAR && !testAndSetVisited(ws, cell - 1)) ws->queue[rear++] = cell - 1;
+        if (y < grid->cols - 1 && row[y + 1] != WALL_CHAR && !testAndSetVisited(ws, cell + 1)) ws->queue[rear++] = cell + 1;
+    }
+    return 0;
+}
+
+// Releases the workspace buffers.
+void freeMazeBfsWorkspace(MazeBfsWorkspace *ws) {
+    free(ws->queue);
+    free(ws->visitedBits);
+    free(ws->wordGeneration);
+    ws->queue = NULL;
+    ws->visitedBits = NULL;
+    ws->wordGeneration = NULL;
+    ws->capacity = 0;
+    ws->generation = 0;
+}
+
+// === MAZE SETUP FUNCTIONS ===
+
+/*
+ * Picks the exit cell of a generated maze and marks it EXIT_CHAR.
+ * Prefers the bottom-right corner cell, then its neighbors, then the last path cell
+ * found scanning backwards from the bottom-right.
+ */
+void placeMazeExit(MazeGrid *grid, int *exitX, int *exitY) {
+    int rows = grid->rows, cols = grid->cols;
+    // Try placing the exit near the bottom-right corner path cell
+    int x = rows - 2;
+    int y = cols - 2;
+    if (MAZE_CELL(grid, x, y) == WALL_CHAR) { // If corner is wall, search nearby
+        int foundExit = 0;
+        // Check adjacent path cells preferred over searching far away
+        if (x > 1 && MAZE_CELL(grid, x - 1, y) == PATH_CHAR) { x--; foundExit = 1; } // Up
+        else if (y > 1 && MAZE_CELL(grid, x, y - 1) == PATH_CHAR) { y--; foundExit = 1; } // Left
+        else if (x < rows - 2 && MAZE_CELL(grid, x + 1, y) == PATH_CHAR) { x++; foundExit = 1; } // Down (less common start)
+        else if (y < cols - 2 && MAZE_CELL(grid, x, y + 1) == PATH_CHAR) { y++; foundExit = 1; } // Right (less common start)
+
+        // If no adjacent path, search backwards from bottom right systematically
+        if (!foundExit) {
+            for (int r = rows - 2; r > 0 && !foundExit; r--) {
+                for (int c = cols - 2; c > 0; c--) {
+                    if (MAZE_CELL(grid, r, c) == PATH_CHAR) {
+                        x = r;
+                        y = c;
+                        foundExit = 1;
+                        break;
+                    }
+                }
+            }
+        }
+        // Absolute fallback if no path found (shouldn't happen with valid generation)
+        if (!foundExit) {
+            fprintf(stderr, "Warning: Could not find a valid exit position! Placing near start.\n");
+            x = 1; y = 3; // Try (1,3)
+            if(MAZE_CELL(grid, x, y) == WALL_CHAR) { x = 3; y = 1; } // Try (3,1)
+            if(MAZE_CELL(grid, x, y) == WALL_CHAR) { x = 1; y = 1; } // Use start itself
+        }
+    }
+    MAZE_CELL(grid, x, y) = EXIT_CHAR; // Mark the chosen exit cell
+    *exitX = x;
+    *exitY = y;
+}
+
+// Number of bonus dots a maze of this size should get (size / 2 for square mazes, at least 1).
+int getBonusDotTarget(const MazeGrid *grid) {
+    int dotsToPlace = (grid->rows + grid->cols) / 4;
+    return (dotsToPlace < 1) ? 1 : dotsToPlace; // Ensure at least one dot
+}
+
+/*
+ * Places up to getBonusDotTarget() bonus dots randomly on PATH_CHAR cells of ctx->grid,
+ * drawing from ctx->rng.
+ * Avoids the start (1, 1), the exit and (avoidX, avoidY) (pass -1, -1 for none).
+ * If 'dots' is not NULL it receives the position of each placed dot and must hold
+ * getBonusDotTarget() entries. Returns the number of dots placed.
+ */
+int placeMazeBonusDots(MazeContext *ctx, int exitX, int exitY, int avoidX, int avoidY, Cell *dots) {
+    MazeGrid *grid = &ctx->grid;
+    int dotsToPlace = getBonusDotTarget(grid);
+    int placed = 0;
+
+    long long attempts = 0;
+    // Limit attempts to prevent infinite loops on very sparse/small mazes
+    const long long maxAttempts = (long long)grid->rows * grid->cols * MAX_BONUS_PLACEMENT_ATTEMPTS_MULTIPLIER;
+
+    while (placed < dotsToPlace && attempts < maxAttempts) {
+        // Generate random coordinates within maze boundaries (excluding border)
+        int randX = 1 + (int)mazeRandBelow(&ctx->rng, (uint32_t)(grid->rows - 2));
+        int randY = 1 + (int)mazeRandBelow(&ctx->rng, (uint32_t)(grid->cols - 2));
+
+        // Check if the random cell is a path and not the start, exit, or avoided cell
+        if (MAZE_CELL(grid, randX, randY) == PATH_CHAR &&
+            !(randX == exitX && randY == exitY) &&        // Not the exit
+            !(randX == 1 && randY == 1) &&                // Not the P1 start
+            !(randX == avoidX && randY == avoidY)         // Not P2 start
+           )
+        {
+            MAZE_CELL(grid, randX, randY) = BONUS_CHAR;
+            if (dots) dots[placed] = (Cell){randX, randY};
+            placed++;
+        }
+        attempts++;
+    }
+    return placed;
+}
+
+// === MAZE GENERATION ALGORITHMS ===
+
+/*
+ * Runs the selected generation algorithm on ctx->grid, which must already be allocated
+ * and all walls, drawing random numbers from ctx->rng only. Contexts share no state,
+ * so different contexts can generate concurrently.
+ * Unknown algorithm numbers fall back to Prim's.
+ */
+void generateMaze(MazeContext *ctx, int algorithm, int startX, int startY) {
+    switch (algorithm) {
+        case ALGORITHM_PRIM: generatePrimMaze(ctx, startX, startY); break;
+        case ALGORITHM_KRUSKAL: generateKruskalMaze(ctx, startX, startY); break;
+        case ALGORITHM_WILSON: generateWilsonMaze(ctx, startX, startY); break;
+        case ALGORITHM_BACKTRACKER: carveMazePathRecursive(ctx, startX, startY); break;
+        case ALGORITHM_BACKTRACKER_ALT: carveMazePathRecursiveAlternative(ctx, startX, startY); break;
+        case ALGORITHM_ELLER: generateEllerMaze(ctx, startX, startY); break;
+        case ALGORITHM_BINARY_TREE: generateBinaryTreeMaze(ctx, startX, startY); break;
+        case ALGORITHM_SIDEWINDER: generateSidewinderMaze(ctx, startX, startY); break;
+        case ALGORITHM_RECURSIVE_DIVISION: generateRecursiveDivisionMaze(ctx, startX, startY); break;
+        default: // Fallback
+            fprintf(stderr, "Warning: Invalid algorithm choice %d, defaulting to Prim's.\n", algorithm);
+            generatePrimMaze(ctx, startX, startY);
+            break;
+    }
+}
+
+// --- Algorithm Table ---
+// Indexed by algorithm number - 1
+typedef struct {
+    const char* name;       // Short display name
+    int connected;          // 1 if every lattice cell is reachable from the start by construction
+} MazeAlgorithmInfo;
+
+static const MazeAlgorithmInfo algorithmTable[NUM_ALGORITHMS] = {
+    {"Prim's", 1},                              // Spanning tree grown from the start cell
+    {"Kruskal's", 1},                           // Union-find merges every cell into one set
+    {"Wilson's", 1},                            // Loop-erased walks always end on the tree
+    {"Recursive Backtracker", 1},               // DFS visits every cell reachable from the start
+    {"Recursive Backtracker (Alternative)", 1}, // Same DFS; extra loop carving only adds passages
+    {"Eller's", 1},                             // Every set keeps a way down; the last row joins them all
+    {"Binary Tree", 1},                         // Every cell links east or south towards the bottom-right corner
+    {"Sidewinder", 1},                          // Every run links south once; the last row is one corridor
+    {"Recursive Division", 1}                   // Every wall keeps one gap, so no chamber is ever cut off
+};
+
+// Returns the short display name of an algorithm ("Unknown" if out of range).
+const char* getAlgorithmName(int algorithm) {
+    if (algorithm < 1 || algorithm > NUM_ALGORITHMS) return "Unknown";
+    return algorithmTable[algorithm - 1].name;
+}
+
+/*
+ * Returns 1 if the algorithm always produces a maze in which every lattice cell
+ * (and therefore any exit placed on one) is reachable from the start, so callers
+ * can skip the BFS validation. Returns 0 for unknown algorithms.
+ */
+int algorithmGuaranteesConnectivity(int algorithm) {
+    if (algorithm < 1 || algorithm > NUM_ALGORITHMS) return 0;
+    return algorithmTable[algorithm - 1].connected;
+}
+
+// --- Backtracker Helpers ---
+
+// One explicit-stack entry of the backtracker: replaces a recursive call frame
+typedef struct {
+    uint32_t x, y;          // Cell being explored
+    unsigned char order;    // Shuffled direction order, 2 bits per slot
+    unsigned char next;     // Next slot of 'order' to try (4 = exhausted)
+} BacktrackFrame;
+
+/*
+ * Marks (x, y) as path and pushes it with a freshly shuffled direction order.
+ * The shuffle draws random numbers exactly like the former recursive version did on entry.
+ */
+static void pushBacktrackFrame(MazeContext *ctx, BacktrackFrame *stack, size_t *depth, int x, int y) {
+    MAZE_CELL(&ctx->grid, x, y) = PATH_CHAR; // Mark current cell as path
+
+    // Shuffle order to randomize direction choice
+    int order[] = {0, 1, 2, 3};
+    for (int i = 0; i < 4; ++i) {
+        int j = (int)mazeRandBelow(&ctx->rng, 4);
+        int temp = order[i];
+        order[i] = order[j];
+        order[j] = temp;
+    }
+
+    BacktrackFrame *frame = &stack[(*depth)++];
+    frame->x = (uint32_t)x;
+    frame->y = (uint32_t)y;
+    frame->order = (unsigned char)(order[0] | (order[1] << 2) | (order[2] << 4) | (order[3] << 6));
+    frame->next = 0;
+}
+
+/*
+ * Depth-first backtracker driven by an explicit stack instead of recursion.
+ * 'dirs' lists the four moves (2 cells at a time) in the order the shuffle indexes them.
+ * If loopChance > 0, a wall towards an already visited neighbor is carved with that
+ * percent chance, creating loops. Visits cells, and draws random numbers, in exactly the
+ * same order as a recursive implementation, so each seed yields the same maze.
+ * The stack holds at most one frame per lattice cell and lives in the context's arena,
+ * so huge mazes need neither deep thread stacks nor per-call allocations.
+ */
+static void runBacktracker(MazeContext *ctx, int startX, int startY, const int dirs[4][2], int loopChance) {
+    MazeGrid *grid = &ctx->grid;
+    size_t maxDepth = (size_t)((grid->rows - 1) / 2) * (size_t)((grid->cols - 1) / 2) + 1;
+    mazeArenaReset(&ctx->arena, maxDepth * sizeof(BacktrackFrame));
+    BacktrackFrame *stack = (BacktrackFrame *)mazeArenaAlloc(&ctx->arena, maxDepth * sizeof(BacktrackFrame));
+    if (!stack) {
+        perror("Error allocating backtracker stack");
+        return;
+    }
+
+    size_t depth = 0;
+    pushBacktrackFrame(ctx, stack, &depth, startX, startY);
+
+    while (depth > 0) {
+        BacktrackFrame *frame = &stack[depth - 1];
+        if (frame->next == 4) { // All directions tried: backtrack
+            depth--;
+            continue;
+        }
+        int dirIdx = (frame->order >> (2 * frame->next)) & 3;
+        frame->next++;
+
+        int x = (int)frame->x, y = (int)frame->y;
+        // Calculate coordinates of neighbor cell (2 steps away) and wall cell (1 step away)
+        int nx = x + dirs[dirIdx][0];
+        int ny = y + dirs[dirIdx][1];
+        int wallX = x + dirs[dirIdx][0] / 2;
+        int wallY = y + dirs[dirIdx][1] / 2;
+
+        // Check if neighbor is within maze bounds
+        if (nx > 0 && nx < grid->rows - 1 && ny > 0 && ny < grid->cols - 1) {
+            // If neighbor is an unvisited wall cell
+            if (MAZE_CELL(grid, nx, ny) == WALL_CHAR) {
+                MAZE_CELL(grid, wallX, wallY) = PATH_CHAR; // Carve the wall
+                pushBacktrackFrame(ctx, stack, &depth, nx, ny); // "Recurse" into neighbor
+            }
+            // Loop Creation Logic: If the wall between current and neighbor still exists,
+            // but the neighbor is already a path (visited via another route),
+            // there's a chance to carve this wall anyway, creating a loop.
+            else if (loopChance > 0 && MAZE_CELL(grid, wallX, wallY) == WALL_CHAR && (int)mazeRandBelow(&ctx->rng, 100) < loopChance) {
+                MAZE_CELL(grid, wallX, wallY) = PATH_CHAR; // Carve wall, creating loop
+            }
+        }
+    }
+}
+
+/*
+ * Generates a maze using the Recursive Backtracking algorithm.
+ * Creates a  maze with no loops but one path from start to exit.
+ * Runs iteratively (see runBacktracker), so it is safe on multi-million-cell mazes.
+ */
+void carveMazePathRecursive(MazeContext *ctx, int x, int y) {
+    // Define directions (move 2 cells at a time) this is by design to ensure walls are always 1 cell away from the path
+    // Rows are {dx, dy}: E, W, S, N
+    static const int dirs[4][2] = {{0, 2}, {0, -2}, {2, 0}, {-2, 0}};
+    runBacktracker(ctx, x, y, dirs, 0);
+}
+
+/*
+ * Generates a maze using a modified Recursive Backtracking algorithm
+ * that introduces a chance of creating loops to add more pathways.
+ * Runs iteratively (see runBacktracker), so it is safe on multi-million-cell mazes.
+ */
+void carveMazePathRecursiveAlternative(MazeContext *ctx, int x, int y) {
+    // 0:Up, 1:Down, 2:Left, 3:Right
+    static const int dirs[4][2] = {{-2, 0}, {2, 0}, {0, -2}, {0, 2}};
+    runBacktracker(ctx, x, y, dirs, 15); // 15% chance to carve a loop
+}
+
+/*
+ * Generates a maze using Prim's algorithm (randomized version).
+ * Starts from a cell, adds its neighbors to a frontier list, and iteratively
+ * connects a random frontier cell to the maze.
+ * Frontier membership is tracked in a bitmap over the odd-cell lattice, so each
+ * cell is checked/added in O(1) and generation is linear in the number of cells.
+ * The frontier and the bitmap live in the context's arena.
+ */
+void generatePrimMaze(MazeContext *ctx, int startX, int startY) {
+    MazeGrid *grid = &ctx->grid;
+    // Dimensions of the cell grid (odd coordinates only)
+    size_t numCellsX = (size_t)(grid->rows - 1) / 2;
+    size_t numCellsY = (size_t)(grid->cols - 1) / 2;
+    size_t totalCells = numCellsX * numCellsY;
+
+    // --- Scratch Memory ---
+    // Every cell enters the frontier at most once, so totalCells is an exact upper bound
+    size_t bitmapBytes = (totalCells + 7) / 8;
+    mazeArenaReset(&ctx->arena, totalCells * sizeof(Cell) + bitmapBytes + 16);
+    Cell *frontier = (Cell*)mazeArenaAlloc(&ctx->arena, totalCells * sizeof(Cell));
+    // One bit per cell: set once the cell has been added to the frontier
+    unsigned char *inFrontier = (unsigned char*)mazeArenaAlloc(&ctx->arena, bitmapBytes);
+    if (!frontier || !inFrontier) {
+        perror("Error allocating frontier in Prim's");
+        return;
+    }
+    memset(inFrontier, 0, bitmapBytes);
+    size_t frontierSize = 0;
+
+    int dirs[4][2] = {{-2, 0}, {2, 0}, {0, -2}, {0, 2}}; // N, S, W, E
+
+    MAZE_CELL(grid, startX, startY) = PATH_CHAR; // Mark start as path
+
+    // --- Add initial frontier cells (neighbors of the start cell) ---
+    for (int i = 0; i < 4; i++) {
+        int nx = startX + dirs[i][0];
+        int ny = startY + dirs[i][1];
+        if (nx > 0 && nx < grid->rows - 1 && ny > 0 && ny < grid->cols - 1) {
+            size_t cellIdx = (size_t)(nx / 2) * numCellsY + (size_t)(ny / 2);
+            inFrontier[cellIdx >> 3] |= (unsigned char)(1 << (cellIdx & 7));
+            frontier[frontierSize++] = (Cell){nx, ny};
+        }
+    }
+
+    // --- Main Prim's Loop ---
+    while (frontierSize > 0) {
+        // Randomly select a cell from the frontier
+        size_t idx = mazeRandBelow(&ctx->rng, (uint32_t)frontierSize);
+        Cell current = frontier[idx];
+
+        // Remove selected cell from frontier (swap with last element)
+        frontier[idx] = frontier[--frontierSize];
+
+        // Find maze neighbors (already path) of the 'current' frontier cell
+        Cell mazeNeighbors[4];
+        int mazeNeighborCount = 0;
+        for (int i = 0; i < 4; i++) {
+            int nx = current.x + dirs[i][0];
+            int ny = current.y + dirs[i][1];
+            if (nx > 0 && nx < grid->rows - 1 && ny > 0 && ny < grid->cols - 1 && MAZE_CELL(grid, nx, ny) == PATH_CHAR) {
+                mazeNeighbors[mazeNeighborCount++] = (Cell){nx, ny};
+            }
+        }
+
+        // If the current frontier cell has neighbors already in the maze
+        if (mazeNeighborCount > 0) {
+            // Randomly choose one maze neighbor to connect to
+            Cell connectTo = mazeNeighbors[mazeRandBelow(&ctx->rng, (uint32_t)mazeNeighborCount)];
+            // Carve wall between current and chosen neighbor
+            int wallX = (current.x + connectTo.x) / 2;
+            int wallY = (current.y + connectTo.y) / 2;
+            MAZE_CELL(grid, wallX, wallY) = PATH_CHAR;
+            MAZE_CELL(grid, current.x, current.y) = PATH_CHAR; // Add current cell to maze path
+
+            // Add *new* frontier neighbors of the 'current' cell
+            for (int i = 0; i < 4; i++) {
+                int nx = current.x + dirs[i][0];
+                int ny = current.y + dirs[i][1];
+                // Check if neighbor is valid and still a wall
+                if (nx > 0 && nx < grid->rows - 1 && ny > 0 && ny < grid->cols - 1 && MAZE_CELL(grid, nx, ny) == WALL_CHAR) {
+                    // O(1) membership test instead of scanning the frontier list
+                    size_t cellIdx = (size_t)(nx / 2) * numCellsY + (size_t)(ny / 2);
+                    unsigned char bit = (unsigned char)(1 << (cellIdx & 7));
+                    if (!(inFrontier[cellIdx >> 3] & bit)) {
+                        inFrontier[cellIdx >> 3] |= bit;
+                        frontier[frontierSize++] = (Cell){nx, ny};
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+// --- Kruskal's Algorithm Helper Functions (DSU) ---
+// Disjoint sets over lattice cells: 'parent' links towards the set's root, 'rank' bounds
+// each root's tree height (union by rank), so finds stay short on any board size.
+
+// DSU: Find the root of the set containing element i (iterative, with path halving)
+static inline uint32_t findKruskalSet(uint32_t *parent, uint32_t i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]]; // Path halving: skip to the grandparent
+        i = parent[i];
+    }
+    return i;
+}
+
+// DSU: Unite the sets with roots rootA and rootB (must differ), attaching the lower-rank tree
+static inline void uniteKruskalSets(uint32_t *parent, unsigned char *rank, uint32_t rootA, uint32_t rootB) {
+    if (rank[rootA] < rank[rootB]) {
+        parent[rootA] = rootB;
+    } else {
+        parent[rootB] = rootA;
+        if (rank[rootA] == rank[rootB]) rank[rootA]++;
+    }
+}
+// --- End Kruskal Helpers ---
+
+
+/*
+ * Generates a maze using Kruskal's algorithm (randomized version).
+ * Treats potential walls as edges, shuffles them, and adds edges (removes walls)
+ * if they connect two previously disconnected components (using DSU).
+ * Each edge is one uint32: (lattice cell << 1) | orientation, where orientation 0 is the
+ * wall to the cell's east and 1 the wall to its south. Edges, parents and ranks all
+ * live in the context's arena, about 13 bytes per lattice cell.
+ */
+void generateKruskalMaze(MazeContext *ctx, int startX, int startY) {
+    MazeGrid *grid = &ctx->grid;
+    // Dimensions of the cell grid (half the maze size)
+    size_t numCellsX = (size_t)(grid->rows - 1) / 2;
+    size_t numCellsY = (size_t)(grid->cols - 1) / 2;
+    size_t totalCells = numCellsX * numCellsY;
+    size_t maxEdges = 2 * totalCells;
+
+    // --- Scratch Memory ---
+    mazeArenaReset(&ctx->arena, (maxEdges + totalCells) * sizeof(uint32_t) + totalCells + 16);
+    uint32_t *edges = (uint32_t *)mazeArenaAlloc(&ctx->arena, maxEdges * sizeof(uint32_t));
+    uint32_t *parent = (uint32_t *)mazeArenaAlloc(&ctx->arena, totalCells * sizeof(uint32_t));
+    unsigned char *rank = (unsigned char *)mazeArenaAlloc(&ctx->arena, totalCells);
+    if (!edges || !parent || !rank) { perror("Error allocating memory in Kruskal's"); return; }
+
+    // --- Disjoint Set Union (DSU) Setup ---
+    for (size_t i = 0; i < totalCells; i++) { parent[i] = (uint32_t)i; } // Each cell is its own set initially
+    memset(rank, 0, totalCells);
+
+    // --- Edge List Generation (row by row; east before south for each cell) ---
+    size_t edgeCount = 0;
+    for (size_t r = 0; r < numCellsX; r++) {
+        for (size_t c = 0; c < numCellsY; c++) {
+            uint32_t cell = (uint32_t)(r * numCellsY + c);
+            if (c + 1 < numCellsY) edges[edgeCount++] = cell << 1;       // Wall to the east
+            if (r + 1 < numCellsX) edges[edgeCount++] = (cell << 1) | 1; // Wall to the south
+        }
+    }
+
+    // --- Shuffle the Edge List in place (Fisher-Yates) ---
+    for (size_t i = (edgeCount > 0 ? edgeCount - 1 : 0); i > 0; i--) {
+        size_t j = mazeRandBelow(&ctx->rng, (uint32_t)(i + 1));
+        uint32_t temp = edges[i]; edges[i] = edges[j]; edges[j] = temp;
+    }
+
+    // --- Process Edges ---
+    // Kruskal's starts with all walls and removes them. Ensure start is path.
+    MAZE_CELL(grid, startX, startY) = PATH_CHAR; // Mark start explicitly
+
+    size_t edgesAdded = 0;
+    for (size_t i = 0; i < edgeCount && edgesAdded + 1 < totalCells; i++) { // Stop when MST is formed
+        uint32_t cell1 = edges[i] >> 1;
+        int south = (int)(edges[i] & 1);
+        uint32_t cell2 = south ? cell1 + (uint32_t)numCellsY : cell1 + 1;
+
+        // Check if the cells are already connected using DSU
+        uint32_t root1 = findKruskalSet(parent, cell1);
+        uint32_t root2 = findKruskalSet(parent, cell2);
+        if (root1 != root2) {
+            // If not connected, unite them
+            uniteKruskalSets(parent, rank, root1, root2);
+
+            // Carve both cells and the wall between them
+            int x1 = 1 + 2 * (int)(cell1 / numCellsY);
+            int y1 = 1 + 2 * (int)(cell1 % numCellsY);
+            MAZE_CELL(grid, x1, y1) = PATH_CHAR;
+            if (south) {
+                MAZE_CELL(grid, x1 + 1, y1) = PATH_CHAR;
+                MAZE_CELL(grid, x1 + 2, y1) = PATH_CHAR;
+            } else {
+                MAZE_CELL(grid, x1, y1 + 1) = PATH_CHAR;
+                MAZE_CELL(grid, x1, y1 + 2) = PATH_CHAR;
+            }
+            edgesAdded++;
+        }
+    }
+}
+
+
+/*
+ * Picks a random direction (0 = N, 1 = S, 2 = W, 3 = E) that keeps a walk at grid cell
+ * (x, y) inside the grid.
+ */
+static inline int pickWilsonDirection(MazeContext *ctx, int x, int y) {
+    const MazeGrid *grid = &ctx->grid;
+    int validDirs[4];
+    int validCount = 0;
+    if (x > 1) validDirs[validCount++] = 0;              // N
+    if (x < grid->rows - 2) validDirs[validCount++] = 1; // S
+    if (y > 1) validDirs[validCount++] = 2;              // W
+    if (y < grid->cols - 2) validDirs[validCount++] = 3; // E
+    return validDirs[mazeRandBelow(&ctx->rng, (uint32_t)validCount)];
+}
+
+// Moves lattice cell 'cell' out of the unvisited list by swapping it with the last entry,
+// so unvisited[unvisitedCount .. total - 1] lists the visited cells.
+static inline void removeWilsonUnvisited(uint32_t *unvisited, uint32_t *position, size_t *unvisitedCount, uint32_t cell) {
+    size_t slot = position[cell];
+    uint32_t last = unvisited[--(*unvisitedCount)];
+    unvisited[slot] = last;
+    position[last] = (uint32_t)slot;
+    unvisited[*unvisitedCount] = cell;
+    position[cell] = (uint32_t)*unvisitedCount;
+}
+
+/*
+ * Generates a spanning tree maze with a hybrid of Aldous-Broder and Wilson's algorithm.
+ * A single random walk from (startX, startY) first covers 'aldousBroderPercent' percent
+ * of the lattice Aldous-Broder style (carving into every cell it reaches first), which
+ * is fast while most cells are new and spares Wilson's its long first walks towards a
+ * tiny tree. Wilson's algorithm then adds the remaining cells.
+ * With 0 or 100 percent the maze is an exactly uniform spanning tree. In between it is
+ * only close to uniform: Wilson's completes the walk's partial tree as if any tree
+ * containing it were equally likely, which slightly favours trees resembling the walk
+ * (measurable on tiny boards). generateWilsonMaze() therefore uses 0.
+ *
+ * Wilson's walks start from cells drawn from a list of unvisited cells (kept compact by
+ * swap-removal through a position index), so picking a start never rejection-samples.
+ * Loops are erased implicitly ("last exit" form): every lattice cell remembers only the
+ * direction the walk last left it by, 2 bits per cell, and retracing those directions
+ * from the walk's start follows the loop-erased path. All scratch memory comes from the
+ * context's arena.
+ */
+void generateHybridWilsonMaze(MazeContext *ctx, int startX, int startY, int aldousBroderPercent) {
+    static const int dirs[4][2] = {{-2, 0}, {2, 0}, {0, -2}, {0, 2}}; // N, S, W, E
+    MazeGrid *grid = &ctx->grid;
+    // Wilson's adds paths to an initially all-wall grid.
+    // initializeMazeState already sets walls, but this ensures it.
+    fillMazeGrid(grid, WALL_CHAR);
+
+    int numCellsX = (grid->rows - 1) / 2;
+    int numCellsY = (grid->cols - 1) / 2;
+    size_t totalCells = (size_t)numCellsX * (size_t)numCellsY;
+    if (aldousBroderPercent < 0) aldousBroderPercent = 0;
+    if (aldousBroderPercent > 100) aldousBroderPercent = 100;
+
+    // --- Scratch: unvisited list + position index (uint32 each), last exits (four cells per byte) ---
+    // Lattice cell (x, y) is index (x / 2) * numCellsY + (y / 2). Last exits never need
+    // clearing, since a walk writes a cell's direction before it can be read back.
+    size_t exitBytes = (totalCells + 3) / 4;
+    mazeArenaReset(&ctx->arena, 2 * totalCells * sizeof(uint32_t) + exitBytes + 16);
+    uint32_t *unvisited = (uint32_t *)mazeArenaAlloc(&ctx->arena, totalCells * sizeof(uint32_t));
+    uint32_t *position = (uint32_t *)mazeArenaAlloc(&ctx->arena, totalCells * sizeof(uint32_t));
+    unsigned char *lastExit = (unsigned char *)mazeArenaAlloc(&ctx->arena, exitBytes);
+    if (!unvisited || !position || !lastExit) {
+        perror("Error allocating memory in Wilson's algorithm");
+        exit(EXIT_FAILURE); // Critical error
+    }
+    for (size_t i = 0; i < totalCells; i++) {
+        unvisited[i] = (uint32_t)i;
+        position[i] = (uint32_t)i;
+    }
+    size_t unvisitedCount = totalCells;
+
+    MAZE_CELL(grid, startX, startY) = PATH_CHAR; // Mark the first cell as part of the maze
+    removeWilsonUnvisited(unvisited, position, &unvisitedCount,
+                          (uint32_t)((size_t)(startX / 2) * numCellsY + (size_t)(startY / 2)));
+
+    // --- Aldous-Broder stage: one walk carving into every cell it enters first ---
+    size_t aldousBroderTarget = totalCells * (size_t)aldousBroderPercent / 100;
+    int currentX = startX;
+    int currentY = startY;
+    while (totalCells - unvisitedCount < aldousBroderTarget) {
+        int dir = pickWilsonDirection(ctx, currentX, currentY);
+        int nextX = currentX + dirs[dir][0];
+        int nextY = currentY + dirs[dir][1];
+        if (MAZE_CELL(grid, nextX, nextY) != PATH_CHAR) {
+            MAZE_CELL(grid, currentX + dirs[dir][0] / 2, currentY + dirs[dir][1] / 2) = PATH_CHAR; // Wall between
+            MAZE_CELL(grid, nextX, nextY) = PATH_CHAR;
+            removeWilsonUnvisited(unvisited, position, &unvisitedCount,
+                                  (uint32_t)((size_t)(nextX / 2) * numCellsY + (size_t)(nextY / 2)));
+        }
+        currentX = nextX;
+        currentY = nextY;
+    }
+
+    // --- Wilson's stage: loop-erased walks from unvisited cells until the tree is spanning ---
+    while (unvisitedCount > 0) {
+        uint32_t walkStart = unvisited[mazeRandBelow(&ctx->rng, (uint32_t)unvisitedCount)];
+        int walkStartX = 1 + 2 * (int)(walkStart / (uint32_t)numCellsY);
+        int walkStartY = 1 + 2 * (int)(walkStart % (uint32_t)numCellsY);
+
+        // Walk until hitting the maze, recording each cell's last exit
+        currentX = walkStartX;
+        currentY = walkStartY;
+        while (MAZE_CELL(grid, currentX, currentY) != PATH_CHAR) {
+            int dir = pickWilsonDirection(ctx, currentX, currentY);
+            size_t cell = (size_t)(currentX / 2) * (size_t)numCellsY + (size_t)(currentY / 2);
+            int shift = (int)(cell & 3) * 2;
+            lastExit[cell >> 2] = (unsigned char)((lastExit[cell >> 2] & ~(3 << shift)) | (dir << shift));
+            currentX += dirs[dir][0];
+            currentY += dirs[dir][1];
+        }
+
+        // Carve the loop-erased path by retracing last exits from the start
+        currentX = walkStartX;
+        currentY = walkStartY;
+        while (MAZE_CELL(grid, currentX, currentY) != PATH_CHAR) {
+            size_t cell = (size_t)(currentX / 2) * (size_t)numCellsY + (size_t)(currentY / 2);
+            MAZE_CELL(grid, currentX, currentY) = PATH_CHAR; // Add cell to maze
+            removeWilsonUnvisited(unvisited, position, &unvisitedCount, (uint32_t)cell);
+
+            int dir = (lastExit[cell >> 2] >> ((cell & 3) * 2)) & 3;
+            MAZE_CELL(grid, currentX + dirs[dir][0] / 2, currentY + dirs[dir][1] / 2) = PATH_CHAR; // Wall towards next cell
+            currentX += dirs[dir][0];
+            currentY += dirs[dir][1];
+        }
+    }
+}
+
+/*
+ * Generates a maze using Wilson's algorithm (exactly uniform spanning tree).
+ * The tree's distribution doesn't depend on which cell the walks run towards, so the
+ * first cell is the lattice center rather than (startX, startY): walks to the center
+ * are about half as long on average as walks to a corner, and far less variable.
+ */
+void generateWilsonMaze(MazeContext *ctx, int startX, int startY) {
+    (void)startX; (void)startY; // See above
+    int centerX = 1 + 2 * (((ctx->grid.rows - 1) / 2) / 2);
+    int centerY = 1 + 2 * (((ctx->grid.cols - 1) / 2) / 2);
+    generateHybridWilsonMaze(ctx, centerX, centerY, 0);
+}
+
+
+// --- Eller's Algorithm ---
+
+// Returns one random bit, drawing a fresh 64-bit word from the RNG every 64 calls.
+static inline int takeRandomBit(MazeRng *rng, uint64_t *bits, int *bitsLeft) {
+    if (*bitsLeft == 0) {
+        *bits = mazeRandNext(rng);
+        *bitsLeft = 64;
+    }
+    (*bitsLeft)--;
+    int bit = (int)(*bits & 1);
+    *bits >>= 1;
+    return bit;
+}
+
+/*
+ * Streams a maze made with Eller's algorithm to 'sink', one grid row at a time from
+ * row 0 to rows - 1, keeping only O(cols) memory, so the height is unlimited.
+ * Cells of the current lattice row that share a set form a circular list (left/right
+ * neighbour arrays) kept in column order. Sets never cross, so cells c and c + 1 are
+ * in the same set exactly when right[c] == c + 1: joins and tests are O(1).
+ * Per lattice row: neighbouring sets are joined at random (always, on the last row),
+ * then every cell except the last remaining member of its set may close its floor;
+ * closed cells start new sets on the next row. Every set thus keeps a way down, and
+ * the finished maze is a spanning tree.
+ * Returns 1 when all rows were delivered, 0 on allocation failure or if the sink
+ * returned 0 to stop early.
+ */
+int streamEllerMaze(MazeRng *rng, long long rows, int cols, MazeRowSink sink, void *user) {
+    long long numCellsX = (rows - 1) / 2;
+    int numCellsY = (cols - 1) / 2;
+    char *cellRow = (char *)malloc((size_t)cols);
+    char *floorRow = (char *)malloc((size_t)cols);
+    int *left = (int *)malloc((size_t)(numCellsY + 1) * sizeof(int));
+    int *right = (int *)malloc((size_t)(numCellsY + 1) * sizeof(int));
+    if (!cellRow || !floorRow || !left || !right) {
+        perror("Error allocating Eller's row buffers");
+        free(cellRow); free(floorRow); free(left); free(right);
+        return 0;
+    }
+    for (int c = 0; c < numCellsY; c++) left[c] = right[c] = c; // Each cell is its own set initially
+
+    uint64_t bits = 0;
+    int bitsLeft = 0;
+    long long x = 0;
+    memset(floorRow, WALL_CHAR, (size_t)cols); // Top border
+    int ok = sink(user, x++, floorRow, cols);
+
+    for (long long r = 0; ok && r < numCellsX; r++) {
+        int lastRow = (r == numCellsX - 1);
+
+        // --- Cell row: join neighbouring sets ---
+        memset(cellRow, WALL_CHAR, (size_t)cols);
+        for (int c = 0; c < numCellsY; c++) cellRow[1 + 2 * c] = PATH_CHAR;
+        for (int c = 0; c + 1 < numCellsY; c++) {
+            int d = c + 1;
+            if (right[c] != d && (lastRow || takeRandomBit(rng, &bits, &bitsLeft))) {
+                // Splice d's list in right after c (keeps column order)
+                right[left[d]] = right[c];
+                left[right[c]] = left[d];
+                right[c] = d;
+                left[d] = c;
+                cellRow[2 + 2 * c] = PATH_CHAR; // Wall between c and d
+            }
+        }
+        ok = sink(user, x++, cellRow, cols);
+        if (lastRow || !ok) break;
+
+        // --- Floor row: open downwards, at least once per set ---
+        memset(floorRow, WALL_CHAR, (size_t)cols);
+        for (int c = 0; c < numCellsY; c++) {
+            if (left[c] != c && takeRandomBit(rng, &bits, &bitsLeft)) {
+                // Close the floor: c leaves its set and starts a new one below
+                right[left[c]] = right[c];
+                left[right[c]] = left[c];
+                left[c] = right[c] = c;
+            } else {
+                floorRow[1 + 2 * c] = PATH_CHAR;
+            }
+        }
+        ok = sink(user, x++, floorRow, cols);
+    }
+
+    // --- Bottom border (and the extra row of an even height) ---
+    memset(floorRow, WALL_CHAR, (size_t)cols);
+    while (ok && x < rows) ok = sink(user, x++, floorRow, cols);
+
+    free(cellRow); free(floorRow); free(left); free(right);
+    return ok;
+}
+
+// Row sink of generateEllerMaze(): copies each streamed row into the grid.
+static int copyEllerRow(void *user, long long x, const char *row, int cols) {
+    MazeGrid *grid = (MazeGrid *)user;
+    memcpy(&MAZE_CELL(grid, x, 0), row, (size_t)cols);
+    return 1;
+}
+
+/*
+ * Generates a maze using Eller's algorithm, streaming the rows into ctx->grid.
+ * Every cell ends up connected, so the start cell needs no special handling.
+ */
+void generateEllerMaze(MazeContext *ctx, int startX, int startY) {
+    (void)startX; (void)startY; // The whole lattice is one tree
+    if (!streamEllerMaze(&ctx->rng, ctx->grid.rows, ctx->grid.cols, copyEllerRow, &ctx->grid)) {
+        exit(EXIT_FAILURE); // Critical error (already reported)
+    }
+}
+
+
+// --- Word-Parallel Generators (Binary Tree, Sidewinder) ---
+// These write MazeWalls planes directly, deciding 64 cells per random word with
+// bitmask operations and no per-cell branches; the *Maze versions unpack into a grid.
+
+// Bits of plane word 'w' that belong to lattice cells (the last word may be partial).
+static inline uint64_t wallWordMask(const MazeWalls *walls, size_t w) {
+    int used = walls->cellCols - (int)(w * 64);
+    return (used >= 64) ? ~(uint64_t)0 : (((uint64_t)1 << used) - 1);
+}
+
+// Bits of plane word 'w' whose cells may open east (all but the last column).
+static inline uint64_t wallWordEastMask(const MazeWalls *walls, size_t w) {
+    uint64_t mask = wallWordMask(walls, w);
+    if (w == walls->wordsPerRow - 1) mask &= ~((uint64_t)1 << ((walls->cellCols - 1) & 63));
+    return mask;
+}
+
+/*
+ * Binary tree maze straight into wall planes sized by allocateMazeWalls() (every word
+ * is overwritten). Each cell opens either east or south, one random bit per cell;
+ * the last column can only go south and the last row only east, so every path
+ * leads to the bottom-right cell and the result is a spanning tree.
+ */
+void generateBinaryTreeWalls(MazeRng *rng, MazeWalls *walls) {
+    size_t wordsPerRow = walls->wordsPerRow;
+    for (int r = 0; r < walls->cellRows; r++) {
+        uint64_t *east = walls->east + (size_t)r * wordsPerRow;
+        uint64_t *south = walls->south + (size_t)r * wordsPerRow;
+        int lastRow = (r == walls->cellRows - 1);
+        for (size_t w = 0; w < wordsPerRow; w++) {
+            uint64_t eastMask = wallWordEastMask(walls, w);
+            east[w] = lastRow ? eastMask : (mazeRandNext(rng) & eastMask);
+            south[w] = lastRow ? 0 : (wallWordMask(walls, w) & ~east[w]);
+        }
+    }
+}
+
+/*
+ * Sidewinder maze straight into wall planes sized by allocateMazeWalls() (every word
+ * is overwritten). In each row a random word decides which cells open east, which
+ * splits the row into runs; every run then opens south exactly once. The last row is
+ * one east-west corridor, so the result is a spanning tree.
+ * The south opening of a run is its first cell whose bit in a second random word is
+ * set (or the run's last cell), found for all runs at once by subtracting the run
+ * starts: the borrow from each start stops at that cell. The borrow also carries over
+ * into the next word for runs crossing a word boundary. (Classic sidewinder picks
+ * uniformly within the run instead; this choice favours the run's start.)
+ */
+void generateSidewinderWalls(MazeRng *rng, MazeWalls *walls) {
+    size_t wordsPerRow = walls->wordsPerRow;
+    for (int r = 0; r < walls->cellRows; r++) {
+        uint64_t *east = walls->east + (size_t)r * wordsPerRow;
+        uint64_t *south = walls->south + (size_t)r * wordsPerRow;
+        if (r == walls->cellRows - 1) { // Last row: one corridor
+            for (size_t w = 0; w < wordsPerRow; w++) {
+                east[w] = wallWordEastMask(walls, w);
+                south[w] = 0;
+            }
+            break;
+        }
+        uint64_t borrow = 0;    // 1 while a run from the previous word has not opened south yet
+        uint64_t carryEast = 0; // East bit of the previous word's last cell
+        for (size_t w = 0; w < wordsPerRow; w++) {
+            uint64_t valid = wallWordMask(walls, w);
+            uint64_t open = mazeRandNext(rng) & wallWordEastMask(walls, w);
+            uint64_t ends = valid & ~open;                      // Last cell of each run
+            uint64_t starts = valid & ~((open << 1) | carryEast); // First cell of each run
+            uint64_t marked = (mazeRandNext(rng) & valid) | ends;  // Candidates; every run has one
+
+            uint64_t partial = marked - starts;
+            uint64_t borrowOut = (marked < starts);
+            uint64_t diff = partial - borrow;
+            borrowOut |= (partial < borrow);
+
+            east[w] = open;
+            south[w] = (marked ^ diff) & marked; // First candidate of every run
+            borrow = borrowOut;
+            carryEast = open >> 63;
+        }
+    }
+}
+
+/*
+ * Runs a wall-plane generator with planes from the context's arena, then opens the
+ * result in ctx->grid (which must be all walls).
+ */
+static void generateGridFromWalls(MazeContext *ctx, void (*generate)(MazeRng *, MazeWalls *)) {
+    MazeWalls walls;
+    setMazeWallsSize(&walls, ctx->grid.rows, ctx->grid.cols);
+    size_t planeBytes = walls.wordsPerRow * (size_t)walls.cellRows * sizeof(uint64_t);
+    mazeArenaReset(&ctx->arena, 2 * planeBytes + 16);
+    walls.east = (uint64_t *)mazeArenaAlloc(&ctx->arena, planeBytes);
+    walls.south = (uint64_t *)mazeArenaAlloc(&ctx->arena, planeBytes);
+    if (!walls.east || !walls.south) {
+        perror("Error allocating wall planes");
+        exit(EXIT_FAILURE); // Critical error
+    }
+    generate(&ctx->rng, &walls);
+    unpackMazeWallRows(&walls, &ctx->grid);
+}
+
+// Generates a binary tree maze (see generateBinaryTreeWalls). Covers every cell.
+void generateBinaryTreeMaze(MazeContext *ctx, int startX, int startY) {
+    (void)startX; (void)startY; // The whole lattice is one tree
+    generateGridFromWalls(ctx, generateBinaryTreeWalls);
+}
+
+// Generates a sidewinder maze (see generateSidewinderWalls). Covers every cell.
+void generateSidewinderMaze(MazeContext *ctx, int startX, int startY) {
+    (void)startX; (void)startY; // The whole lattice is one tree
+    generateGridFromWalls(ctx, generateSidewinderWalls);
+}
+
+
+// --- Recursive Division ---
+#define MAZE_DIVISION_STACK 64 // Pending chambers; smaller-half-first keeps this above log2(cells)
+
+/*
+ * Turns the grid into an open field: every lattice cell and every wall between two
+ * lattice cells is open, only the border and the even/even posts stay walls.
+ */
+void openMazeField(MazeGrid *grid) {
+    fillMazeGrid(grid, WALL_CHAR);
+    int cellRows = (grid->rows - 1) / 2;
+    int cellCols = (grid->cols - 1) / 2;
+    for (int x = 1; x < 2 * cellRows; x++) {
+        char *row = &MAZE_CELL(grid, x, 0);
+        if (x % 2 == 1) {
+            memset(row + 1, PATH_CHAR, (size_t)(2 * cellCols - 1)); // Cells and the walls between them
+        } else {
+            for (int c = 0; c < cellCols; c++) row[2 * c + 1] = PATH_CHAR; // Walls to the row below
+        }
+    }
+}
+
+/*
+ * One recursive division step: closes a wall line across 'chamber' with a single random
+ * gap and stores the two subchambers in 'halves'. The line runs across the longer side
+ * (random orientation for square chambers). Returns 2, or 0 if the chamber is one cell
+ * wide or high and needs no further walls.
+ */
+int splitMazeChamber(MazeRng *rng, MazeGrid *grid, MazeChamber chamber, MazeChamber halves[2]) {
+    if (chamber.rows < 2 || chamber.cols < 2) return 0;
+    int horizontal = (chamber.rows > chamber.cols) ||
+                     (chamber.rows == chamber.cols && (mazeRandNext(rng) >> 63));
+    halves[0] = halves[1] = chamber;
+    if (horizontal) {
+        // Wall between lattice rows row + split - 1 and row + split
+        int split = 1 + (int)mazeRandBelow(rng, (uint32_t)(chamber.rows - 1));
+        int gap = (int)mazeRandBelow(rng, (uint32_t)chamber.cols);
+        char *wallRow = &MAZE_CELL(grid, 2 * (chamber.row + split), 0);
+        for (int c = 0; c < chamber.cols; c++) {
+            if (c != gap) wallRow[2 * (chamber.col + c) + 1] = WALL_CHAR;
+        }
+        halves[0].rows = split;
+        halves[1].row += split;
+        halves[1].rows -= split;
+    } else {
+        // Wall between lattice columns col + split - 1 and col + split
+        int split = 1 + (int)mazeRandBelow(rng, (uint32_t)(chamber.cols - 1));
+        int gap = (int)mazeRandBelow(rng, (uint32_t)chamber.rows);
+        int wallY = 2 * (chamber.col + split);
+        for (int r = 0; r < chamber.rows; r++) {
+            if (r != gap) MAZE_CELL(grid, 2 * (chamber.row + r) + 1, wallY) = WALL_CHAR;
+        }
+        halves[0].cols = split;
+        halves[1].col += split;
+        halves[1].cols -= split;
+    }
+    return 2;
+}
+
+/*
+ * Divides an open chamber down to single-cell corridors. Uses an explicit stack instead
+ * of recursion: after each split the larger half is pushed and the smaller one is
+ * divided next, so at most log2(cells) chambers are ever pending (no heap, no deep
+ * recursion). Chambers don't overlap, so different chambers of one grid can be divided
+ * concurrently, each with its own RNG.
+ */
+void divideMazeChamber(MazeRng *rng, MazeGrid *grid, MazeChamber chamber) {
+    MazeChamber stack[MAZE_DIVISION_STACK];
+    int depth = 0;
+    stack[depth++] = chamber;
+    while (depth > 0) {
+        MazeChamber current = stack[--depth];
+        MazeChamber halves[2];
+        while (splitMazeChamber(rng, grid, current, halves)) {
+            long long area0 = (long long)halves[0].rows * halves[0].cols;
+            long long area1 = (long long)halves[1].rows * halves[1].cols;
+            int larger = (area1 > area0);
+            stack[depth++] = halves[larger];    // Larger half waits (at least halves the area below it)
+            current = halves[!larger];          // Smaller half goes on
+        }
+    }
+}
+
+/*
+ * Generates a maze with recursive division: starts from an open field and adds walls,
+ * each with one gap, until every chamber is a corridor. The result is a spanning tree.
+ */
+void generateRecursiveDivisionMaze(MazeContext *ctx, int startX, int startY) {
+    (void)startX; (void)startY; // The whole lattice is one tree
+    MazeChamber board = {0, 0, (ctx->grid.rows - 1) / 2, (ctx->grid.cols - 1) / 2};
+    openMazeField(&ctx->grid);
+    divideMazeChamber(&ctx->rng, &ctx->grid, board);
+}
@@ -0,0 +1,206 @@
+// C-MAZE ENGINE - Maze storage and generation algorithms
+// Note: This part of C-Maze is plain C99 with no console or OS specific calls,
+// so it can be shared by the game (c-maze-v2.c) and the command line tools.
+#ifndef MAZE_ENGINE_H
+#define MAZE_ENGINE_H
+
+#include <stddef.h>   // For size_t
+#include <stdint.h>   // For uint64_t
+
+// --- Maze Cell Characters ---
+#define WALL_CHAR    '`' // Using backtick for wall (can be invisible/customizable)
+#define PATH_CHAR    ' '
+#define EXIT_CHAR    'E'
+#define BONUS_CHAR   '.'
+
+// --- Maze Size Settings ---
+// Limits apply to width and height separately; boards may be rectangular.
+// Cell counts are computed in size_t, so MAX_SIZE x MAX_SIZE cannot overflow.
+#define DEFAULT_SIZE 21  // Default dimension (must be odd)
+#define MIN_SIZE 5
+#define MAX_SIZE 20001   // 10k x 10k lattice cells
+
+// --- Bonus Dots ---
+#define MAX_BONUS_PLACEMENT_ATTEMPTS_MULTIPLIER 2 // Random placement attempts per grid cell
+
+// --- Generator Version ---
+// Bump whenever a change alters the maze produced for a given seed, so stored
+// boards (see maze-library.h) are never mistaken for the current generator's output.
+#define MAZE_GENERATOR_VERSION 3
+
+// --- Maze Generation Algorithms ---
+// Numbering matches the choices shown by promptForAlgorithm()
+#define ALGORITHM_PRIM                  1
+#define ALGORITHM_KRUSKAL               2
+#define ALGORITHM_WILSON                3
+#define ALGORITHM_BACKTRACKER           4
+#define ALGORITHM_BACKTRACKER_ALT       5
+#define ALGORITHM_ELLER                 6
+#define ALGORITHM_BINARY_TREE           7
+#define ALGORITHM_SIDEWINDER            8
+#define ALGORITHM_RECURSIVE_DIVISION    9
+#define NUM_ALGORITHMS                  9
+
+// Suggested Aldous-Broder share for generateHybridWilsonMaze(): fastest on large boards
+#define MAZE_WILSON_ALDOUS_BRODER_PERCENT 30
+
+// --- Structs ---
+// Represents a cell coordinate (used in Prim's)
+typedef struct {
+    int x, y;
+} Cell;
+
+// --- Maze Grid ---
+// One contiguous block of rows * stride chars; x indexes rows, y indexes columns.
+#define MAZE_GRID_ALIGNMENT 64 // Cache line size; rows start on their own cache line
+typedef struct {
+    int rows, cols;   // Grid dimensions (odd numbers, border included)
+    size_t stride;    // Bytes between the start of consecutive rows (cols rounded up)
+    char *cells;      // MAZE_GRID_ALIGNMENT aligned cell storage
+} MazeGrid;
+
+// Accesses cell (x, y) of a grid pointer; usable as an lvalue
+#define MAZE_CELL(grid, x, y) ((grid)->cells[(size_t)(x) * (grid)->stride + (size_t)(y)])
+
+// Packed wall layout: two bit planes over the odd-cell lattice (see packMazeWalls)
+typedef struct {
+    int rows, cols;         // Dimensions of the grid the planes were packed from
+    int cellRows, cellCols; // Lattice cells per column / row: (rows - 1) / 2, (cols - 1) / 2
+    size_t wordsPerRow;     // 64-bit words per plane row
+    uint64_t *east;         // Bit set: lattice cell (r, c) opens to (r, c + 1)
+    uint64_t *south;        // Bit set: lattice cell (r, c) opens to (r + 1, c)
+} MazeWalls;
+
+// Tests bit (r, c) of a wall plane
+#define MAZE_WALL_OPEN(plane, wordsPerRow, r, c) \
+    (((plane)[(size_t)(r) * (wordsPerRow) + ((size_t)(c) >> 6)] >> ((c) & 63)) & 1)
+
+// Reusable scratch memory: reserved once, handed out with a bump pointer
+typedef struct {
+    unsigned char *base;
+    size_t used;      // Bytes handed out since the last reset
+    size_t capacity;  // Bytes reserved
+} MazeArena;
+
+// Reusable BFS state for isCellReachable (zero-initialize before first use)
+typedef struct {
+    uint32_t *queue;          // Packed cell indices (x * cols + y)
+    uint64_t *visitedBits;    // One visited bit per cell
+    uint32_t *wordGeneration; // Search generation that last wrote each 64-bit visited word
+    size_t capacity;          // Cells the buffers can hold
+    uint32_t generation;      // Current search; words with an older stamp read as unvisited
+} MazeBfsWorkspace;
+
+// --- Random Numbers ---
+// Per-context xoshiro256** generator, seeded through splitmix64. Engine-owned, so a
+// seed gives the same board with every compiler and C library, and fast enough for
+// the generators' inner loops (hence inline).
+typedef struct {
+    uint64_t s[4];
+} MazeRng;
+
+static inline uint64_t mazeRngRotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+// Next 64 random bits
+static inline uint64_t mazeRandNext(MazeRng *rng) {
+    uint64_t *s = rng->s;
+    uint64_t result = mazeRngRotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = mazeRngRotl(s[3], 45);
+    return result;
+}
+
+/*
+ * Uniform number in 0 .. bound - 1 (bound > 0) without modulo bias: Lemire's
+ * multiply-shift method, which needs a division only on the rare rejection path.
+ */
+static inline uint32_t mazeRandBelow(MazeRng *rng, uint32_t bound) {
+    uint64_t m = (mazeRandNext(rng) >> 32) * (uint64_t)bound;
+    uint32_t low = (uint32_t)m;
+    if (low < bound) {
+        uint32_t threshold = (uint32_t)(0u - bound) % bound; // 2^32 mod bound
+        while (low < threshold) {
+            m = (mazeRandNext(rng) >> 32) * (uint64_t)bound;
+            low = (uint32_t)m;
+        }
+    }
+    return (uint32_t)(m >> 32);
+}
+
+// Rectangle of lattice cells (row, col = top-left lattice cell) for recursive division
+typedef struct {
+    int row, col;
+    int rows, cols;
+} MazeChamber;
+
+// Receives grid row x of a streamed maze (cols chars, borders included) and returns 1
+// to continue or 0 to stop; the row buffer is only valid during the call
+typedef int (*MazeRowSink)(void *user, long long x, const char *row, int cols);
+
+// Everything one maze generation job touches. Generators use nothing else, so one
+// context per thread makes generation re-entrant (zero-initialize before first use).
+typedef struct {
+    MazeGrid grid;          // Board being generated
+    MazeRng rng;            // Seeded with mazeRngSeed() before each board
+    MazeArena arena;        // Generator scratch memory, reused across boards
+    MazeBfsWorkspace bfs;   // For isCellReachable() on this context's boards
+} MazeContext;
+
+// --- Function Prototypes ---
+
+// Maze Storage
+void allocateMazeGrid(MazeGrid *grid, int rows, int cols);  // Allocates a contiguous rows x cols grid filled with walls
+void freeMazeGrid(MazeGrid *grid);  // Frees the grid memory
+void fillMazeGrid(MazeGrid *grid, char value);  // Sets every cell to 'value'
+int allocateMazeWalls(MazeWalls *walls, int rows, int cols);   // Allocates zeroed wall planes for a rows x cols grid
+int packMazeWalls(const MazeGrid *grid, MazeWalls *walls);  // Packs a generated grid into east/south wall bit planes
+void packMazeWallRows(const MazeGrid *grid, uint64_t *east, uint64_t *south, size_t wordsPerRow); // Packs into caller-owned zeroed planes
+void unpackMazeWalls(const MazeWalls *walls, MazeGrid *grid);   // Allocates 'grid' and rebuilds it from wall bit planes
+void unpackMazeWallRows(const MazeWalls *walls, MazeGrid *grid); // Opens the planes' passages in an existing all-wall grid
+int mazeWallsCellOpen(const MazeWalls *walls, int x, int y); // Reads one grid cell from the wall planes
+void freeMazeWalls(MazeWalls *walls);   // Frees the wall bit planes
+int mazeArenaReset(MazeArena *arena, size_t capacity);  // Empties the arena, growing it to at least 'capacity' bytes
+void* mazeArenaAlloc(MazeArena *arena, size_t size);    // Bump-allocates from the reserved capacity
+void freeMazeArena(MazeArena *arena);   // Releases the arena's memory
+void mazeRngSeed(MazeRng *rng, unsigned int seed);  // Restarts the random sequence for 'seed'
+void mazeRngSeedStream(MazeRng *rng, unsigned int seed, uint64_t stream); // Independent sub-sequence 'stream' of 'seed'
+void freeMazeContext(MazeContext *ctx); // Frees the context's grid and scratch buffers
+
+// Maze Setup
+void placeMazeExit(MazeGrid *grid, int *exitX, int *exitY); // Marks the exit near the bottom-right corner
+int getBonusDotTarget(const MazeGrid *grid);    // Number of bonus dots for this maze size
+int placeMazeBonusDots(MazeContext *ctx, int exitX, int exitY, int avoidX, int avoidY, Cell *dots);  // Places dots, returns count
+
+// Maze Validation
+int isCellReachable(const MazeGrid *grid, MazeBfsWorkspace *ws, int startX, int startY, int targetX, int targetY);   // BFS path check
+void freeMazeBfsWorkspace(MazeBfsWorkspace *ws);    // Frees the BFS workspace buffers
+
+// Maze Generation Algorithms
+void generateMaze(MazeContext *ctx, int algorithm, int startX, int startY);  // Runs the selected algorithm on the context's all-wall grid
+const char* getAlgorithmName(int algorithm);   // Short display name of an algorithm
+int algorithmGuaranteesConnectivity(int algorithm);    // 1 if the exit is reachable by construction (no BFS needed)
+void carveMazePathRecursive(MazeContext *ctx, int startX, int startY);    // Recursive backtracking algorithm (explicit stack)
+void carveMazePathRecursiveAlternative(MazeContext *ctx, int startX, int startY); // Backtracking with 15% loop carving (explicit stack)
+void generatePrimMaze(MazeContext *ctx, int startX, int startY);  // Prim's algorithm for maze generation
+void generateKruskalMaze(MazeContext *ctx, int startX, int startY);   // Kruskal's algorithm for maze generation (packed edges, union-by-rank DSU)
+void generateWilsonMaze(MazeContext *ctx, int startX, int startY);    // Wilson's algorithm for maze generation
+void generateEllerMaze(MazeContext *ctx, int startX, int startY);     // Eller's algorithm, row by row
+int streamEllerMaze(MazeRng *rng, long long rows, int cols, MazeRowSink sink, void *user); // Eller's rows to a sink in O(cols) memory
+void generateBinaryTreeMaze(MazeContext *ctx, int startX, int startY);    // Binary tree (word-parallel)
+void generateSidewinderMaze(MazeContext *ctx, int startX, int startY);    // Sidewinder (word-parallel)
+void generateBinaryTreeWalls(MazeRng *rng, MazeWalls *walls);   // Binary tree straight into wall planes, 64 cells per random word
+void generateSidewinderWalls(MazeRng *rng, MazeWalls *walls);   // Sidewinder straight into wall planes, 64 cells per random word
+void generateRecursiveDivisionMaze(MazeContext *ctx, int startX, int startY);   // Recursive division (adds walls to an open field)
+void openMazeField(MazeGrid *grid); // Opens every lattice cell and inner wall (division starting point)
+int splitMazeChamber(MazeRng *rng, MazeGrid *grid, MazeChamber chamber, MazeChamber halves[2]); // One division step; 2 halves or 0
+void divideMazeChamber(MazeRng *rng, MazeGrid *grid, MazeChamber chamber);  // Divides a chamber completely (O(log n) stack)
+void generateHybridWilsonMaze(MazeContext *ctx, int startX, int startY, int aldousBroderPercent); // Aldous-Broder walk over a share of the cells, then Wilson's (near-uniform)
+
+#endif // MAZE_ENGINE_H
@@ -0,0 +1,230 @@
+// C-MAZE FRAME - Whole-screen frame compositor
+// See maze-frame.h for how frames are drawn and flushed.
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>   // For va_list in printMazeFrame()
+#include <string.h>   // For memcpy()
+
+#ifdef _WIN32
+#include <windows.h>  // For WriteConsoleOutputA()
+#endif
+
+#include "maze-frame.h"
+
+#define MAZE_FRAME_TEXT_MAX 256 // Longest printMazeFrame() result
+#define MAZE_FRAME_SKIP_MIN 4   // Unchanged cells worth a cursor move instead of resending them
+
+// === FRAME DRAWING FUNCTIONS ===
+
+/*
+ * Allocates a width x height frame of blank cells (spaces, black on black). Every cell
+ * starts changed, so the first flush paints the whole area.
+ * Returns 1 on success, 0 if memory could not be allocated.
+ */
+int allocateMazeFrame(MazeFrame *frame, int width, int height) {
+    memset(frame, 0, sizeof(*frame));
+    frame->cells = (MazeFrameCell *)calloc((size_t)width * (size_t)height, sizeof(MazeFrameCell));
+    frame->front = (MazeFrameCell *)malloc((size_t)width * (size_t)height * sizeof(MazeFrameCell));
+    frame->dirtyFirst = (int *)malloc((size_t)height * sizeof(int));
+    frame->dirtyLast = (int *)malloc((size_t)height * sizeof(int));
+    if (!frame->cells || !frame->front || !frame->dirtyFirst || !frame->dirtyLast) {
+        perror("Error allocating frame buffer");
+        freeMazeFrame(frame);
+        return 0;
+    }
+    frame->width = width;
+    frame->height = height;
+    for (size_t i = 0; i < (size_t)width * (size_t)height; i++) frame->cells[i].ch = ' ';
+    invalidateMazeFrame(frame);
+    return 1;
+}
+
+// Frees the frame's buffers; the frame can be allocated again afterwards.
+void freeMazeFrame(MazeFrame *frame) {
+    free(frame->cells);
+    free(frame->front);
+    free(frame->dirtyFirst);
+    free(frame->dirtyLast);
+    free(frame->out);
+    memset(frame, 0, sizeof(*frame));
+}
+
+// Marks every cell changed, e.g. after the screen was cleared behind the frame's back.
+void invalidateMazeFrame(MazeFrame *frame) {
+    for (int row = 0; row < frame->height; row++) {
+        frame->dirtyFirst[row] = 0;
+        frame->dirtyLast[row] = frame->width - 1;
+    }
+    frame->dirtyTop = 0;
+    frame->dirtyBottom = frame->height - 1;
+    frame->frontValid = 0;
+}
+
+// Copies the changed spans to the front buffer and marks everything clean after a flush.
+static void clearMazeFrameDirty(MazeFrame *frame) {
+    for (int row = frame->dirtyTop; row <= frame->dirtyBottom; row++) {
+        if (frame->dirtyFirst[row] <= frame->dirtyLast[row]) {
+            size_t start = (size_t)row * (size_t)frame->width + (size_t)frame->dirtyFirst[row];
+            memcpy(&frame->front[start], &frame->cells[start],
+                   (size_t)(frame->dirtyLast[row] - frame->dirtyFirst[row] + 1) * sizeof(MazeFrameCell));
+        }
+        frame->dirtyFirst[row] = frame->width;
+        frame->dirtyLast[row] = -1;
+    }
+    frame->dirtyTop = frame->height;
+    frame->dirtyBottom = -1;
+    frame->frontValid = 1;
+}
+
+/*
+ * Draws one cell. Cells outside the frame are ignored, and a cell that already holds
+ * 'ch' with 'attr' is not marked changed, so redrawing a whole area costs no output.
+ */
+void setMazeFrameCell(MazeFrame *frame, int row, int col, char ch, MazeColor attr) {
+    if (row < 0 || row >= frame->height || col < 0 || col >= frame->width) return;
+    MazeFrameCell *cell = &frame->cells[(size_t)row * (size_t)frame->width + (size_t)col];
+    if (cell->ch == ch && cell->attr == attr) return;
+    cell->ch = ch;
+    cell->attr = attr;
+
+    if (col < frame->dirtyFirst[row]) frame->dirtyFirst[row] = col;
+    if (col > frame->dirtyLast[row]) frame->dirtyLast[row] = col;
+    if (row < frame->dirtyTop) frame->dirtyTop = row;
+    if (row > frame->dirtyBottom) frame->dirtyBottom = row;
+}
+
+// Draws 'text' from (row, col), clipped at the right edge. Returns the column after it.
+int putMazeFrameText(MazeFrame *frame, int row, int col, MazeColor attr, const char *text) {
+    for (; *text && col < frame->width; text++, col++) {
+        setMazeFrameCell(frame, row, col, *text, attr);
+    }
+    return col;
+}
+
+// printf() into the frame at (row, col); at most MAZE_FRAME_TEXT_MAX - 1 characters. Returns the column after it.
+int printMazeFrame(MazeFrame *frame, int row, int col, MazeColor attr, const char *format, ...) {
+    char text[MAZE_FRAME_TEXT_MAX];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    return putMazeFrameText(frame, row, col, attr, text);
+}
+
+// Blanks row 'row' from column 'col' to the right edge with spaces in 'attr'.
+void clearMazeFrameRow(MazeFrame *frame, int row, int col, MazeColor attr) {
+    for (; col < frame->width; col++) {
+        setMazeFrameCell(frame, row, col, ' ', attr);
+    }
+}
+
+// === FRAME OUTPUT FUNCTIONS ===
+
+// Grows the flush buffer to at least 'bytes'. Returns 1 on success, 0 on failure.
+static int reserveMazeFrameOutput(MazeFrame *frame, size_t bytes) {
+    if (frame->outCapacity >= bytes) return 1;
+    char *grown = (char *)realloc(frame->out, bytes);
+    if (!grown) {
+        perror("Error allocating frame output buffer");
+        return 0;
+    }
+    frame->out = grown;
+    frame->outCapacity = bytes;
+    return 1;
+}
+
+#ifdef _WIN32
+
+/*
+ * Windows: copies the bounding rectangle of all changes into CHAR_INFO records and
+ * writes it with a single WriteConsoleOutputA() call. Colors are mapped to the
+ * console's 16 (getMazeConsoleAttribute()).
+ */
+int flushMazeFrame(MazeFrame *frame) {
+    if (frame->dirtyTop > frame->dirtyBottom) return 1; // Nothing changed
+    int left = frame->width, right = -1;
+    for (int row = frame->dirtyTop; row <= frame->dirtyBottom; row++) {
+        if (frame->dirtyFirst[row] < left) left = frame->dirtyFirst[row];
+        if (frame->dirtyLast[row] > right) right = frame->dirtyLast[row];
+    }
+    int width = right - left + 1;
+    int height = frame->dirtyBottom - frame->dirtyTop + 1;
+    if (!reserveMazeFrameOutput(frame, (size_t)width * (size_t)height * sizeof(CHAR_INFO))) return 0;
+
+    CHAR_INFO *records = (CHAR_INFO *)frame->out;
+    for (int row = 0; row < height; row++) {
+        const MazeFrameCell *cell = &frame->cells[(size_t)(frame->dirtyTop + row) * (size_t)frame->width + (size_t)left];
+        for (int col = 0; col < width; col++) {
+            records[row * width + col].Char.AsciiChar = cell[col].ch;
+            records[row * width + col].Attributes = (WORD)getMazeConsoleAttribute(cell[col].attr);
+        }
+    }
+
+    COORD size = {(SHORT)width, (SHORT)height};
+    COORD origin = {0, 0};
+    SMALL_RECT area = {(SHORT)left, (SHORT)frame->dirtyTop, (SHORT)right, (SHORT)frame->dirtyBottom};
+    int ok = WriteConsoleOutputA(GetStdHandle(STD_OUTPUT_HANDLE), records, size, origin, &area) != 0;
+    clearMazeFrameDirty(frame);
+    return ok;
+}
+
+#else
+
+// Appends the SGR sequence selecting 'attr' (256-color foreground and background) at 'p'; returns the bytes written.
+static int appendAnsiAttr(char *p, MazeColor attr) {
+    return sprintf(p, "\x1b[38;5;%d;48;5;%dm", MAZE_COLOR_FG(attr), MAZE_COLOR_BG(attr));
+}
+
+// 1 if cell 'index' already shows the same thing on screen.
+static inline int isMazeFrameCellShown(const MazeFrame *frame, size_t index) {
+    return frame->frontValid && frame->cells[index].ch == frame->front[index].ch && frame->cells[index].attr == frame->front[index].attr;
+}
+
+/*
+ * Elsewhere: encodes every changed span as cursor moves plus its characters, with an
+ * SGR sequence only where the color changes, and sends it all with one writeMazeTerm().
+ * Runs of at least MAZE_FRAME_SKIP_MIN unchanged cells inside a span (e.g. between the
+ * two halves of a split view) are skipped with a cursor move.
+ */
+int flushMazeFrame(MazeFrame *frame) {
+    if (frame->dirtyTop > frame->dirtyBottom) return 1; // Nothing changed
+
+    // --- Worst case: a cursor move per row, a color change per cell ---
+    size_t cells = 0;
+    for (int row = frame->dirtyTop; row <= frame->dirtyBottom; row++) {
+        if (frame->dirtyFirst[row] <= frame->dirtyLast[row]) cells += (size_t)(frame->dirtyLast[row] - frame->dirtyFirst[row] + 1);
+    }
+    if (!reserveMazeFrameOutput(frame, cells * 36 + (size_t)(frame->dirtyBottom - frame->dirtyTop + 1) * 24 + 16)) return 0;
+
+    char *p = frame->out;
+    int attr = -1; // Unknown: the first cell sets it
+    for (int row = frame->dirtyTop; row <= frame->dirtyBottom; row++) {
+        size_t rowStart = (size_t)row * (size_t)frame->width;
+        int cursor = -1; // Column the cursor is at, -1 if not on this row
+        for (int col = frame->dirtyFirst[row]; col <= frame->dirtyLast[row]; col++) {
+            if (isMazeFrameCellShown(frame, rowStart + (size_t)col)) {
+                // --- Skip a long enough run of unchanged cells ---
+                int end = col;
+                while (end <= frame->dirtyLast[row] && isMazeFrameCellShown(frame, rowStart + (size_t)end)) end++;
+                if (end > frame->dirtyLast[row] || end - col >= MAZE_FRAME_SKIP_MIN || cursor != col) {
+                    col = end - 1;
+                    continue;
+                }
+            }
+            if (cursor != col) p += sprintf(p, "\x1b[%d;%dH", row + 1, col + 1);
+            const MazeFrameCell *cell = &frame->cells[rowStart + (size_t)col];
+            if (cell->attr != attr) {
+                attr = cell->attr;
+                p += appendAnsiAttr(p, cell->attr);
+            }
+            *p++ = cell->ch;
+            cursor = col + 1;
+        }
+    }
+    memcpy(p, "\x1b[0m", 4); // Leave the terminal's colors as they were
+    p += 4;
+    clearMazeFrameDirty(frame);
+    return writeMazeTerm(frame->out, (size_t)(p - frame->out));
+}
+
+#endif
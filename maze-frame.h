@@ -0,0 +1,46 @@
+// C-MAZE FRAME - Whole-screen frame compositor
+// Note: Plain C99. flushMazeFrame() is the only OS-specific part: one WriteConsoleOutput()
+// call on Windows, one write of an ANSI/VT byte stream (maze-term.h) everywhere else.
+//
+// A frame is one contiguous buffer of character + attribute cells covering the board and
+// the status area, plus a front copy of what the screen shows. Drawing only touches
+// memory; cells whose value really changes are recorded as a changed column span per
+// row. A flush then sends every changed span in one call (skipping cells inside a span
+// that match the front copy), with color changes coalesced into runs, so a full redraw
+// costs a handful of syscalls and a move costs a few bytes.
+#ifndef MAZE_FRAME_H
+#define MAZE_FRAME_H
+
+#include <stddef.h>
+
+#include "maze-term.h"  // MazeColor
+
+// --- Structs ---
+typedef struct {
+    char ch;
+    MazeColor attr;     // 256-color foreground/background (MAZE_COLOR)
+} MazeFrameCell;
+
+typedef struct {
+    int width, height;
+    MazeFrameCell *cells;   // Row-major; what the screen shows after the next flush
+    MazeFrameCell *front;   // Row-major; what the screen shows now (if frontValid)
+    int frontValid;         // 0 until the first flush, or after invalidateMazeFrame()
+    int *dirtyFirst;        // Per row: first changed column (> dirtyLast when clean)
+    int *dirtyLast;         // Per row: last changed column
+    int dirtyTop, dirtyBottom;  // Rows with changes (dirtyTop > dirtyBottom when clean)
+    char *out;              // Flush buffer (ANSI bytes or CHAR_INFO records)
+    size_t outCapacity;
+} MazeFrame;
+
+// --- Function Prototypes ---
+int allocateMazeFrame(MazeFrame *frame, int width, int height);    // Blank frame, fully dirty; 1 on success
+void freeMazeFrame(MazeFrame *frame);   // Frees the frame's buffers
+void invalidateMazeFrame(MazeFrame *frame); // Marks every cell changed (after the screen was cleared)
+void setMazeFrameCell(MazeFrame *frame, int row, int col, char ch, MazeColor attr); // Draws one cell
+int putMazeFrameText(MazeFrame *frame, int row, int col, MazeColor attr, const char *text); // Returns the column after it
+int printMazeFrame(MazeFrame *frame, int row, int col, MazeColor attr, const char *format, ...); // printf() into the frame
+void clearMazeFrameRow(MazeFrame *frame, int row, int col, MazeColor attr); // Blanks a row from 'col' to the right edge
+int flushMazeFrame(MazeFrame *frame);   // Sends all changes to the console in one call; 1 on success
+
+#endif // MAZE_FRAME_H
@@ -0,0 +1,461 @@
+// C-MAZE LIBRARY - Append-only binary container for pre-generated boards
+// See maze-library.h for the file layout.
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L // For mmap(), fstat()
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>  // For CreateFileMapping(), MapViewOfFile()
+#else
+#include <fcntl.h>    // For open()
+#include <unistd.h>   // For close()
+#include <sys/mman.h> // For mmap(), munmap()
+#include <sys/stat.h> // For fstat()
+#endif
+
+#include "maze-library.h"
+
+// === BYTE ORDER HELPERS ===
+
+static void storeLE16(unsigned char *p, uint16_t value) {
+    p[0] = (unsigned char)value;
+    p[1] = (unsigned char)(value >> 8);
+}
+
+static void storeLE32(unsigned char *p, uint32_t value) {
+    p[0] = (unsigned char)value;
+    p[1] = (unsigned char)(value >> 8);
+    p[2] = (unsigned char)(value >> 16);
+    p[3] = (unsigned char)(value >> 24);
+}
+
+static uint32_t loadLE32(const unsigned char *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// 1 on little-endian hosts, where wall planes can be written as packed without swapping
+static int hostIsLittleEndian() {
+    const uint16_t probe = 1;
+    return *(const unsigned char*)&probe == 1;
+}
+
+// Rewrites 'count' native uint64 words in place as little-endian bytes.
+static void wordsToLE64(uint64_t *words, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        uint64_t value = words[i];
+        unsigned char *p = (unsigned char*)&words[i];
+        for (int b = 0; b < 8; b++) p[b] = (unsigned char)(value >> (8 * b));
+    }
+}
+
+// === WRITER FUNCTIONS ===
+
+/*
+ * Opens 'path' for appending, creating it with a file header if it is empty.
+ * An existing file must carry a matching format and generator version, so boards
+ * produced by an older generator are never mixed with new ones.
+ * Returns 1 on success, 0 on failure (with an error message printed).
+ */
+int openMazeLibraryWriter(MazeLibraryWriter *writer, const char *path) {
+    memset(writer, 0, sizeof(*writer));
+    writer->file = fopen(path, "a+b"); // Reads allowed anywhere, writes always append
+    if (!writer->file) {
+        perror("Error opening maze library");
+        return 0;
+    }
+    // setvbuf must come before any other operation on the stream
+    writer->fileBuffer = (char*)malloc(MAZE_LIBRARY_WRITE_BUFFER);
+    if (writer->fileBuffer) setvbuf(writer->file, writer->fileBuffer, _IOFBF, MAZE_LIBRARY_WRITE_BUFFER);
+
+    unsigned char header[MAZE_LIBRARY_HEADER_SIZE];
+    rewind(writer->file);
+    size_t existing = fread(header, 1, sizeof(header), writer->file);
+    fseek(writer->file, 0, SEEK_END); // Required between a read and a write
+    if (existing == 0) {
+        // --- New library: write the file header ---
+        memset(header, 0, sizeof(header));
+        memcpy(header, MAZE_LIBRARY_MAGIC, 4);
+        storeLE16(header + 4, MAZE_LIBRARY_VERSION);
+        storeLE16(header + 6, MAZE_LIBRARY_HEADER_SIZE);
+        storeLE32(header + 8, MAZE_GENERATOR_VERSION);
+        if (fwrite(header, 1, sizeof(header), writer->file) != sizeof(header)) {
+            perror("Error writing maze library header");
+            closeMazeLibraryWriter(writer);
+            return 0;
+        }
+        writer->bytesWritten = MAZE_LIBRARY_HEADER_SIZE;
+    } else if (existing != sizeof(header) || memcmp(header, MAZE_LIBRARY_MAGIC, 4) != 0 ||
+               header[4] != MAZE_LIBRARY_VERSION || header[5] != 0) {
+        fprintf(stderr, "Error: %s is not a version %d maze library.\n", path, MAZE_LIBRARY_VERSION);
+        closeMazeLibraryWriter(writer);
+        return 0;
+    } else if (loadLE32(header + 8) != MAZE_GENERATOR_VERSION) {
+        fprintf(stderr, "Error: %s holds boards from generator version %u (current is %d).\n",
+                path, (unsigned int)loadLE32(header + 8), MAZE_GENERATOR_VERSION);
+        closeMazeLibraryWriter(writer);
+        return 0;
+    } else if (ftell(writer->file) % 8 != 0) {
+        // Records are 8-byte multiples; anything else means an interrupted append
+        fprintf(stderr, "Error: %s ends with a truncated record.\n", path);
+        closeMazeLibraryWriter(writer);
+        return 0;
+    }
+    return 1;
+}
+
+/*
+ * Serializes one board into 'record', growing its buffer if needed.
+ * 'grid' must be a generated maze with its exit and dots placed; 'dots' lists the
+ * dotCount bonus dot cells (may be NULL when dotCount is 0). Touches nothing but
+ * its arguments, so worker threads can encode boards in parallel.
+ * Returns 1 on success, 0 on failure.
+ */
+int encodeMazeLibraryRecord(MazeLibraryRecord *record, const MazeGrid *grid, unsigned int seed, int algorithm,
+                            int exitX, int exitY, const Cell *dots, int dotCount) {
+    int cellRows = (grid->rows - 1) / 2;
+    int cellCols = (grid->cols - 1) / 2;
+    size_t wordsPerRow = ((size_t)cellCols + 63) / 64;
+    size_t planeWords = (size_t)cellRows * wordsPerRow;
+    size_t dotBytes = (MAZE_LIBRARY_RECORD_HEADER_SIZE + (size_t)dotCount * 4 + 7) & ~(size_t)7; // Header + dots, padded
+    size_t recordBytes = dotBytes + 2 * planeWords * sizeof(uint64_t);
+    if (recordBytes > UINT32_MAX) {
+        fprintf(stderr, "Error: %dx%d maze is too large for a library record.\n", grid->cols, grid->rows);
+        return 0;
+    }
+
+    // --- Grow the reusable record buffer if needed ---
+    if (recordBytes > record->capacity) {
+        // malloc alignment covers uint64_t, and the planes start at a multiple of 8
+        unsigned char *grown = (unsigned char*)realloc(record->data, recordBytes);
+        if (!grown) {
+            perror("Error allocating maze library record buffer");
+            return 0;
+        }
+        record->data = grown;
+        record->capacity = recordBytes;
+    }
+    unsigned char *out = record->data;
+    memset(out, 0, recordBytes);
+    record->size = recordBytes;
+
+    // --- Record header ---
+    const uint32_t fields[10] = {
+        (uint32_t)recordBytes, (uint32_t)seed, (uint32_t)grid->rows, (uint32_t)grid->cols, (uint32_t)algorithm,
+        (uint32_t)exitX, (uint32_t)exitY, (uint32_t)dotCount, (uint32_t)wordsPerRow, 0 // Flags (reserved)
+    };
+    for (int i = 0; i < 10; i++) storeLE32(out + 4 * i, fields[i]);
+
+    // --- Dot cells ---
+    for (int i = 0; i < dotCount; i++) {
+        storeLE32(out + MAZE_LIBRARY_RECORD_HEADER_SIZE + 4 * (size_t)i,
+                  (uint32_t)((size_t)dots[i].x * grid->cols + dots[i].y));
+    }
+
+    // --- Wall planes, packed straight into the record ---
+    uint64_t *east = (uint64_t*)(out + dotBytes);
+    uint64_t *south = east + planeWords;
+    packMazeWallRows(grid, east, south, wordsPerRow);
+    if (!hostIsLittleEndian()) wordsToLE64(east, 2 * planeWords);
+    return 1;
+}
+
+// Appends an encoded record with a single fwrite. Returns 1 on success, 0 on failure.
+int writeMazeLibraryRecord(MazeLibraryWriter *writer, const MazeLibraryRecord *record) {
+    if (fwrite(record->data, 1, record->size, writer->file) != record->size) {
+        perror("Error writing maze library record");
+        return 0;
+    }
+    writer->recordsWritten++;
+    writer->bytesWritten += (long long)record->size;
+    return 1;
+}
+
+/*
+ * Serializes one board into the writer's record buffer and appends it.
+ * Returns 1 on success, 0 on failure.
+ */
+int appendMazeLibraryRecord(MazeLibraryWriter *writer, const MazeGrid *grid, unsigned int seed, int algorithm,
+                            int exitX, int exitY, const Cell *dots, int dotCount) {
+    return encodeMazeLibraryRecord(&writer->record, grid, seed, algorithm, exitX, exitY, dots, dotCount) &&
+           writeMazeLibraryRecord(writer, &writer->record);
+}
+
+// Frees a record buffer and leaves it empty.
+void freeMazeLibraryRecord(MazeLibraryRecord *record) {
+    free(record->data);
+    record->data = NULL;
+    record->size = 0;
+    record->capacity = 0;
+}
+
+// Flushes and closes the library file and frees the writer's buffers. Returns 1 on success.
+int closeMazeLibraryWriter(MazeLibraryWriter *writer) {
+    int ok = 1;
+    if (writer->file) {
+        if (fclose(writer->file) != 0) {
+            perror("Error closing maze library");
+            ok = 0;
+        }
+        writer->file = NULL;
+    }
+    free(writer->fileBuffer); // Only after fclose: stdio may still use it while flushing
+    writer->fileBuffer = NULL;
+    freeMazeLibraryRecord(&writer->record);
+    return ok;
+}
+
+// === READER FUNCTIONS ===
+
+// Mixes a board key into a hash index slot number.
+static size_t hashBoardKey(uint32_t seed, uint32_t rows, uint32_t cols, uint32_t algorithm) {
+    uint64_t h = ((uint64_t)seed << 32) ^ ((uint64_t)rows << 20) ^ ((uint64_t)cols << 4) ^ algorithm;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return (size_t)h;
+}
+
+// Maps the whole file read-only. Returns 1 on success, 0 on failure.
+static int mapLibraryFile(MazeLibraryReader *reader, const char *path) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        fprintf(stderr, "Error opening maze library %s (error %lu).\n", path, (unsigned long)GetLastError());
+        return 0;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < MAZE_LIBRARY_HEADER_SIZE) {
+        fprintf(stderr, "Error: %s is too small to be a maze library.\n", path);
+        CloseHandle(file);
+        return 0;
+    }
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file); // The mapping keeps the file open
+    if (!mapping) {
+        fprintf(stderr, "Error mapping maze library %s (error %lu).\n", path, (unsigned long)GetLastError());
+        return 0;
+    }
+    const void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        fprintf(stderr, "Error mapping maze library %s (error %lu).\n", path, (unsigned long)GetLastError());
+        CloseHandle(mapping);
+        return 0;
+    }
+    reader->data = (const unsigned char*)view;
+    reader->size = (size_t)fileSize.QuadPart;
+    reader->mappingHandle = mapping;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        perror("Error opening maze library");
+        return 0;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < MAZE_LIBRARY_HEADER_SIZE) {
+        fprintf(stderr, "Error: %s is too small to be a maze library.\n", path);
+        close(fd);
+        return 0;
+    }
+    void *view = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); // The mapping keeps the file referenced
+    if (view == MAP_FAILED) {
+        perror("Error mapping maze library");
+        return 0;
+    }
+    reader->data = (const unsigned char*)view;
+    reader->size = (size_t)info.st_size;
+#endif
+    return 1;
+}
+
+// Unmaps whatever mapLibraryFile() mapped.
+static void unmapLibraryFile(MazeLibraryReader *reader) {
+    if (!reader->data) return;
+#ifdef _WIN32
+    UnmapViewOfFile(reader->data);
+    CloseHandle((HANDLE)reader->mappingHandle);
+#else
+    munmap((void*)reader->data, reader->size);
+#endif
+    reader->data = NULL;
+    reader->mappingHandle = NULL;
+}
+
+/*
+ * Checks the record at 'offset' against the file bounds and the size implied by its
+ * own header, and checks that the exit and every bonus dot are interior cells of the
+ * board, since loading writes them into a grid of that size.
+ * Returns its byte length, or 0 if it is truncated or malformed.
+ */
+static size_t validateLibraryRecord(const MazeLibraryReader *reader, size_t offset) {
+    if (reader->size - offset < MAZE_LIBRARY_RECORD_HEADER_SIZE) return 0;
+    const unsigned char *p = reader->data + offset;
+    size_t recordBytes = loadLE32(p);
+    uint32_t rows = loadLE32(p + 8), cols = loadLE32(p + 12);
+    uint32_t dotCount = loadLE32(p + 28), wordsPerRow = loadLE32(p + 32);
+    if (rows < MIN_SIZE || cols < MIN_SIZE || rows > MAX_SIZE || cols > MAX_SIZE || rows % 2 == 0 || cols % 2 == 0) return 0;
+    if (wordsPerRow != ((cols - 1) / 2 + 63) / 64 || dotCount > rows * cols) return 0;
+
+    size_t dotBytes = (MAZE_LIBRARY_RECORD_HEADER_SIZE + (size_t)dotCount * 4 + 7) & ~(size_t)7;
+    size_t expected = dotBytes + 2 * (size_t)((rows - 1) / 2) * wordsPerRow * sizeof(uint64_t);
+    if (recordBytes != expected || recordBytes > reader->size - offset) return 0;
+
+    // --- Exit and dots must lie inside the outer wall ---
+    uint32_t exitX = loadLE32(p + 20), exitY = loadLE32(p + 24);
+    if (exitX < 1 || exitX > rows - 2 || exitY < 1 || exitY > cols - 2) return 0;
+    for (uint32_t i = 0; i < dotCount; i++) {
+        uint32_t cell = loadLE32(p + MAZE_LIBRARY_RECORD_HEADER_SIZE + 4 * (size_t)i);
+        uint32_t x = cell / cols, y = cell % cols;
+        if (cell >= rows * cols || x < 1 || x > rows - 2 || y < 1 || y > cols - 2) return 0;
+    }
+    return recordBytes;
+}
+
+/*
+ * Memory-maps a library file and builds an in-memory hash index over its records,
+ * keyed by (seed, rows, cols, algorithm). Building the index reads only the record
+ * headers; wall planes are not touched until a board is used. A truncated or corrupt
+ * tail (e.g. from an interrupted batch run) is reported and left out of the index.
+ * Wall planes are used in place, so the reader requires a little-endian host.
+ * Returns 1 on success, 0 on failure (the reader is then left closed).
+ */
+int openMazeLibraryReader(MazeLibraryReader *reader, const char *path) {
+    memset(reader, 0, sizeof(*reader));
+    if (!hostIsLittleEndian()) {
+        fprintf(stderr, "Error: Maze libraries can only be mapped on little-endian hosts.\n");
+        return 0;
+    }
+    if (!mapLibraryFile(reader, path)) return 0;
+
+    // --- Check the file header ---
+    const unsigned char *header = reader->data;
+    if (memcmp(header, MAZE_LIBRARY_MAGIC, 4) != 0 || header[4] != MAZE_LIBRARY_VERSION || header[5] != 0) {
+        fprintf(stderr, "Error: %s is not a version %d maze library.\n", path, MAZE_LIBRARY_VERSION);
+        closeMazeLibraryReader(reader);
+        return 0;
+    }
+    if (loadLE32(header + 8) != MAZE_GENERATOR_VERSION) {
+        fprintf(stderr, "Error: %s holds boards from generator version %u (current is %d).\n",
+                path, (unsigned int)loadLE32(header + 8), MAZE_GENERATOR_VERSION);
+        closeMazeLibraryReader(reader);
+        return 0;
+    }
+
+    // --- Count valid records ---
+    size_t offset = MAZE_LIBRARY_HEADER_SIZE;
+    long long records = 0;
+    size_t recordBytes;
+    while (offset < reader->size && (recordBytes = validateLibraryRecord(reader, offset)) != 0) {
+        records++;
+        offset += recordBytes;
+    }
+    if (offset != reader->size) {
+        fprintf(stderr, "Warning: %s has a truncated or corrupt record at byte %llu; later boards are ignored.\n",
+                path, (unsigned long long)offset);
+    }
+
+    // --- Build the index (load factor <= 1/2) ---
+    size_t slots = 16;
+    while (slots < (size_t)records * 2) slots *= 2;
+    reader->index = (MazeLibraryIndexEntry*)calloc(slots, sizeof(MazeLibraryIndexEntry));
+    if (!reader->index) {
+        perror("Error allocating maze library index");
+        closeMazeLibraryReader(reader);
+        return 0;
+    }
+    reader->indexMask = slots - 1;
+    reader->minSeed = UINT32_MAX;
+    offset = MAZE_LIBRARY_HEADER_SIZE;
+    for (long long i = 0; i < records; i++) {
+        const unsigned char *p = reader->data + offset;
+        uint32_t seed = loadLE32(p + 4), rows = loadLE32(p + 8), cols = loadLE32(p + 12), algorithm = loadLE32(p + 16);
+        size_t slot = hashBoardKey(seed, rows, cols, algorithm) & reader->indexMask;
+        while (reader->index[slot].offset != 0) {
+            const MazeLibraryIndexEntry *e = &reader->index[slot];
+            if (e->seed == seed && e->rows == rows && e->cols == cols && e->algorithm == algorithm) break; // Keep the first copy
+            slot = (slot + 1) & reader->indexMask;
+        }
+        if (reader->index[slot].offset == 0) {
+            MazeLibraryIndexEntry entry = {seed, rows, cols, algorithm, offset};
+            reader->index[slot] = entry;
+            reader->recordCount++;
+            if (seed < reader->minSeed) reader->minSeed = seed;
+            if (seed > reader->maxSeed) reader->maxSeed = seed;
+        }
+        offset += loadLE32(p);
+    }
+    if (reader->recordCount == 0) reader->minSeed = 0;
+    return 1;
+}
+
+/*
+ * Looks up a board by (seed, rows, cols, algorithm) in O(1) expected time and fills
+ * 'board' with pointers into the mapping; nothing is copied. Returns 1 if found, 0 if not.
+ */
+int findMazeLibraryBoard(const MazeLibraryReader *reader, unsigned int seed, int rows, int cols, int algorithm,
+                         MazeLibraryBoard *board) {
+    if (!reader->index) return 0;
+    size_t slot = hashBoardKey(seed, (uint32_t)rows, (uint32_t)cols, (uint32_t)algorithm) & reader->indexMask;
+    const MazeLibraryIndexEntry *e;
+    while ((e = &reader->index[slot])->offset != 0) {
+        if (e->seed == seed && e->rows == (uint32_t)rows && e->cols == (uint32_t)cols && e->algorithm == (uint32_t)algorithm) {
+            const unsigned char *p = reader->data + e->offset;
+            uint32_t dotCount = loadLE32(p + 28);
+            size_t wordsPerRow = loadLE32(p + 32);
+            size_t dotBytes = (MAZE_LIBRARY_RECORD_HEADER_SIZE + (size_t)dotCount * 4 + 7) & ~(size_t)7;
+
+            board->seed = seed;
+            board->algorithm = algorithm;
+            board->exitX = (int)loadLE32(p + 20);
+            board->exitY = (int)loadLE32(p + 24);
+            board->dotCount = (int)dotCount;
+            board->dots = p + MAZE_LIBRARY_RECORD_HEADER_SIZE;
+            board->walls.rows = rows;
+            board->walls.cols = cols;
+            board->walls.cellRows = (rows - 1) / 2;
+            board->walls.cellCols = (cols - 1) / 2;
+            board->walls.wordsPerRow = wordsPerRow;
+            // Records start on 8-byte file offsets and the mapping is page aligned
+            board->walls.east = (uint64_t*)(p + dotBytes);
+            board->walls.south = board->walls.east + (size_t)board->walls.cellRows * wordsPerRow;
+            return 1;
+        }
+        slot = (slot + 1) & reader->indexMask;
+    }
+    return 0;
+}
+
+// Decodes the grid position of bonus dot 'i' of a library board.
+void getMazeLibraryDot(const MazeLibraryBoard *board, int i, int *x, int *y) {
+    uint32_t cell = loadLE32(board->dots + 4 * (size_t)i);
+    *x = (int)(cell / (uint32_t)board->walls.cols);
+    *y = (int)(cell % (uint32_t)board->walls.cols);
+}
+
+/*
+ * Allocates 'grid' and fills it with a playable copy of a library board: walls, the
+ * exit and the bonus dots. For callers that mutate the board; read-only users can
+ * query the mapping directly with MAZE_LIBRARY_CELL_OPEN.
+ */
+void loadMazeLibraryBoard(const MazeLibraryBoard *board, MazeGrid *grid) {
+    unpackMazeWalls(&board->walls, grid);
+    MAZE_CELL(grid, board->exitX, board->exitY) = EXIT_CHAR;
+    for (int i = 0; i < board->dotCount; i++) {
+        int x, y;
+        getMazeLibraryDot(board, i, &x, &y);
+        MAZE_CELL(grid, x, y) = BONUS_CHAR;
+    }
+}
+
+// Unmaps the library and frees its index. Safe to call on a closed reader.
+void closeMazeLibraryReader(MazeLibraryReader *reader) {
+    unmapLibraryFile(reader);
+    free(reader->index);
+    reader->index = NULL;
+    reader->indexMask = 0;
+    reader->recordCount = 0;
+}
@@ -0,0 +1,95 @@
+// C-MAZE LIBRARY - Append-only binary container for pre-generated boards
+// Note: The writer is plain C99 like the engine; the reader memory-maps the file
+// (mmap on POSIX, MapViewOfFile on Windows). All integers are stored little-endian.
+//
+// File layout:
+//   File header (16 bytes): "CMZL", uint16 format version, uint16 header size,
+//                           uint32 MAZE_GENERATOR_VERSION, uint32 reserved
+//   Records, back to back, each a multiple of 8 bytes:
+//     Record header (10 x uint32): record bytes, seed, rows, cols, algorithm,
+//                                  exit x, exit y, dot count, words per row, flags
+//     Dot cells (dot count x uint32, packed as x * cols + y), zero padded to 8 bytes
+//     East wall plane, then south wall plane ((rows - 1) / 2 x words per row uint64 each,
+//     same bit layout as MazeWalls)
+// Every plane therefore starts on an 8-byte boundary of the file.
+#ifndef MAZE_LIBRARY_H
+#define MAZE_LIBRARY_H
+
+#include <stdio.h>    // For FILE
+#include <stddef.h>   // For size_t
+#include <stdint.h>   // For uint32_t
+
+#include "maze-engine.h"
+
+// --- Container Format ---
+#define MAZE_LIBRARY_MAGIC          "CMZL"
+#define MAZE_LIBRARY_VERSION        1
+#define MAZE_LIBRARY_HEADER_SIZE    16  // File header bytes
+#define MAZE_LIBRARY_RECORD_HEADER_SIZE 40  // Record header bytes (10 x uint32)
+#define MAZE_LIBRARY_WRITE_BUFFER   (1 << 20)   // stdio buffer for the output file
+
+// --- Structs ---
+// One serialized record; the buffer is reused across boards (zero-initialize before first use)
+typedef struct {
+    unsigned char *data;
+    size_t size;        // Bytes of the encoded record
+    size_t capacity;    // Bytes allocated for 'data'
+} MazeLibraryRecord;
+
+// Appends records to a library file
+typedef struct {
+    FILE *file;
+    MazeLibraryRecord record;   // Serialization buffer for appendMazeLibraryRecord()
+    char *fileBuffer;       // Large stdio buffer so appends stream at disk speed
+    long long recordsWritten;
+    long long bytesWritten;
+} MazeLibraryWriter;
+
+// One slot of the reader's hash index (open addressing, linear probing)
+typedef struct {
+    uint32_t seed, rows, cols, algorithm;   // Lookup key
+    size_t offset;  // Record offset in the file; 0 marks an empty slot (offset 0 is the file header)
+} MazeLibraryIndexEntry;
+
+// Read-only view of a memory-mapped library
+typedef struct {
+    const unsigned char *data;  // Start of the mapping
+    size_t size;                // Mapped bytes
+    void *mappingHandle;        // Windows file mapping handle (unused on POSIX)
+    MazeLibraryIndexEntry *index;
+    size_t indexMask;           // Index slots - 1 (slot count is a power of two)
+    long long recordCount;      // Records indexed
+    unsigned int minSeed, maxSeed;  // Seed range present in the library
+} MazeLibraryReader;
+
+// A board found in a library; its wall planes point straight into the mapping
+typedef struct {
+    unsigned int seed;
+    int algorithm;
+    int exitX, exitY;
+    int dotCount;
+    const unsigned char *dots;  // dotCount little-endian uint32 cells (x * cols + y)
+    MazeWalls walls;            // Read-only planes inside the mapping; never freeMazeWalls() these
+} MazeLibraryBoard;
+
+// Tests whether grid cell (x, y) of a library board is open, reading the wall planes in place
+#define MAZE_LIBRARY_CELL_OPEN(board, x, y) mazeWallsCellOpen(&(board)->walls, (x), (y))
+
+// --- Function Prototypes ---
+int openMazeLibraryWriter(MazeLibraryWriter *writer, const char *path); // Opens/creates a library for appending
+int appendMazeLibraryRecord(MazeLibraryWriter *writer, const MazeGrid *grid, unsigned int seed, int algorithm,
+                            int exitX, int exitY, const Cell *dots, int dotCount);   // Writes one board
+int closeMazeLibraryWriter(MazeLibraryWriter *writer);  // Flushes and closes the library
+int encodeMazeLibraryRecord(MazeLibraryRecord *record, const MazeGrid *grid, unsigned int seed, int algorithm,
+                            int exitX, int exitY, const Cell *dots, int dotCount);   // Serializes one board (thread-safe)
+int writeMazeLibraryRecord(MazeLibraryWriter *writer, const MazeLibraryRecord *record); // Appends an encoded record
+void freeMazeLibraryRecord(MazeLibraryRecord *record);  // Frees a record buffer
+
+int openMazeLibraryReader(MazeLibraryReader *reader, const char *path); // Maps a library and indexes its records
+int findMazeLibraryBoard(const MazeLibraryReader *reader, unsigned int seed, int rows, int cols, int algorithm,
+                         MazeLibraryBoard *board); // O(1) lookup; 1 if found
+void getMazeLibraryDot(const MazeLibraryBoard *board, int i, int *x, int *y); // Grid position of bonus dot i
+void loadMazeLibraryBoard(const MazeLibraryBoard *board, MazeGrid *grid);   // Allocates a playable grid copy
+void closeMazeLibraryReader(MazeLibraryReader *reader); // Unmaps the file and frees the index
+
+#endif // MAZE_LIBRARY_H
@@ -0,0 +1,237 @@
+// C-MAZE POOL - Work-stealing thread pool for parallel maze generation
+// See maze-pool.h for the scheduling scheme.
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L // For sysconf()
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+#ifdef _WIN32
+#include <windows.h>  // For GetSystemInfo()
+#else
+#include <unistd.h>   // For sysconf()
+#endif
+
+#include "maze-pool.h"
+
+// --- Structs ---
+// Indices [next, end) still owned by one worker. Padded to a cache line so
+// workers polling their own range don't slow each other down.
+typedef struct {
+    pthread_mutex_t lock;
+    size_t next, end;
+    char padding[64];
+} MazePoolRange;
+
+struct MazePool {
+    int threads;                // Workers including the calling thread
+    pthread_t *handles;         // threads - 1 background workers
+    MazePoolRange *ranges;      // One per worker
+
+    pthread_mutex_t lock;       // Guards everything below
+    pthread_cond_t wake;        // Signals a new loop (or shutdown) to the workers
+    pthread_cond_t finished;    // Signals the caller that all workers are idle again
+    unsigned long round;        // Incremented for every parallel loop
+    int busyWorkers;            // Background workers still inside the current loop
+    int stopping;
+    MazePoolTask task;
+    void *user;
+};
+
+// Start-up argument of a background worker
+typedef struct {
+    MazePool *pool;
+    int worker;
+} MazePoolWorkerArgs;
+
+// === POOL FUNCTIONS ===
+
+// Returns the number of online CPUs, or 1 if it cannot be determined.
+int getMazeProcessorCount() {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (info.dwNumberOfProcessors > 0) ? (int)info.dwNumberOfProcessors : 1;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return (count > 0) ? (int)count : 1;
+#endif
+}
+
+/*
+ * Takes the next index from the worker's own range, or steals the back half of the
+ * first non-empty range after it. Returns 1 with *index set, or 0 when no work is left.
+ */
+static int takeMazePoolIndex(MazePool *pool, int worker, size_t *index) {
+    MazePoolRange *own = &pool->ranges[worker];
+    for (;;) {
+        pthread_mutex_lock(&own->lock);
+        if (own->next < own->end) {
+            *index = own->next++;
+            pthread_mutex_unlock(&own->lock);
+            return 1;
+        }
+        pthread_mutex_unlock(&own->lock);
+
+        // --- Own range is empty: steal from the others, starting with the next worker ---
+        int stole = 0;
+        for (int i = 1; i < pool->threads && !stole; i++) {
+            MazePoolRange *victim = &pool->ranges[(worker + i) % pool->threads];
+            pthread_mutex_lock(&victim->lock);
+            size_t remaining = victim->end - victim->next;
+            if (remaining > 0) {
+                size_t take = (remaining + 1) / 2; // Back half, rounded up so the last index moves too
+                size_t from = victim->end - take;
+                size_t to = victim->end;
+                victim->end = from;
+                pthread_mutex_unlock(&victim->lock);
+
+                pthread_mutex_lock(&own->lock);
+                own->next = from;
+                own->end = to;
+                pthread_mutex_unlock(&own->lock);
+                stole = 1;
+            } else {
+                pthread_mutex_unlock(&victim->lock);
+            }
+        }
+        if (!stole) return 0; // Every range is empty: the loop is (being) finished
+    }
+}
+
+// Runs jobs of the current loop on one worker until none are left anywhere.
+static void runMazePoolWorker(MazePool *pool, int worker) {
+    size_t index;
+    while (takeMazePoolIndex(pool, worker, &index)) {
+        pool->task(pool->user, index, worker);
+    }
+}
+
+// Body of a background worker thread: wait for a loop, help run it, repeat.
+static void* mazePoolThreadMain(void *arg) {
+    MazePoolWorkerArgs *args = (MazePoolWorkerArgs*)arg;
+    MazePool *pool = args->pool;
+    int worker = args->worker;
+    free(args);
+
+    unsigned long seenRound = 0;
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (!pool->stopping && pool->round == seenRound) {
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        }
+        if (pool->stopping) break;
+        seenRound = pool->round;
+        pthread_mutex_unlock(&pool->lock);
+
+        runMazePoolWorker(pool, worker);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->busyWorkers == 0) pthread_cond_signal(&pool->finished);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+/*
+ * Creates a pool of 'threads' workers (values < 1 mean one per CPU). The calling
+ * thread counts as worker 0, so threads - 1 background threads are started.
+ * Returns NULL if the pool could not be created.
+ */
+MazePool* createMazePool(int threads) {
+    if (threads < 1) threads = getMazeProcessorCount();
+    MazePool *pool = (MazePool*)calloc(1, sizeof(MazePool));
+    if (!pool) {
+        perror("Error allocating thread pool");
+        return NULL;
+    }
+    pool->ranges = (MazePoolRange*)calloc((size_t)threads, sizeof(MazePoolRange));
+    pool->handles = (pthread_t*)calloc((size_t)threads, sizeof(pthread_t));
+    if (!pool->ranges || !pool->handles) {
+        perror("Error allocating thread pool");
+        free(pool->ranges); free(pool->handles); free(pool);
+        return NULL;
+    }
+    pool->threads = threads;
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    pthread_cond_init(&pool->finished, NULL);
+    for (int i = 0; i < threads; i++) pthread_mutex_init(&pool->ranges[i].lock, NULL);
+
+    // --- Start background workers 1 .. threads - 1 ---
+    for (int i = 1; i < threads; i++) {
+        MazePoolWorkerArgs *args = (MazePoolWorkerArgs*)malloc(sizeof(MazePoolWorkerArgs));
+        if (args) {
+            args->pool = pool;
+            args->worker = i;
+        }
+        if (!args || pthread_create(&pool->handles[i], NULL, mazePoolThreadMain, args) != 0) {
+            free(args);
+            fprintf(stderr, "Warning: Could only start %d of %d worker threads.\n", i, threads);
+            pool->threads = i; // Run with the workers that did start
+            break;
+        }
+    }
+    return pool;
+}
+
+// Returns the number of workers, including the calling thread.
+int getMazePoolThreads(const MazePool *pool) {
+    return pool->threads;
+}
+
+/*
+ * Calls task(user, i, worker) for every i in 0 .. count - 1 across all workers and
+ * returns once every call has finished. Indices run in no particular order; tasks
+ * that need ordered results should write them to slot i and let the caller consume
+ * the slots in order afterwards.
+ */
+void mazePoolParallelFor(MazePool *pool, size_t count, MazePoolTask task, void *user) {
+    if (count == 0) return;
+
+    // --- Deal out equal contiguous ranges ---
+    size_t start = 0;
+    for (int i = 0; i < pool->threads; i++) {
+        size_t share = count / (size_t)pool->threads + ((size_t)i < count % (size_t)pool->threads ? 1 : 0);
+        pthread_mutex_lock(&pool->ranges[i].lock);
+        pool->ranges[i].next = start;
+        pool->ranges[i].end = start + share;
+        pthread_mutex_unlock(&pool->ranges[i].lock);
+        start += share;
+    }
+
+    // --- Wake the background workers and join in as worker 0 ---
+    pthread_mutex_lock(&pool->lock);
+    pool->task = task;
+    pool->user = user;
+    pool->busyWorkers = pool->threads - 1;
+    pool->round++;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    runMazePoolWorker(pool, 0);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->busyWorkers > 0) pthread_cond_wait(&pool->finished, &pool->lock);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+// Stops the background workers, waits for them and frees the pool. Safe with NULL.
+void destroyMazePool(MazePool *pool) {
+    if (!pool) return;
+    pthread_mutex_lock(&pool->lock);
+    pool->stopping = 1;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+    for (int i = 1; i < pool->threads; i++) pthread_join(pool->handles[i], NULL);
+
+    for (int i = 0; i < pool->threads; i++) pthread_mutex_destroy(&pool->ranges[i].lock);
+    pthread_cond_destroy(&pool->finished);
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->ranges);
+    free(pool->handles);
+    free(pool);
+}
@@ -0,0 +1,27 @@
+// C-MAZE POOL - Work-stealing thread pool for parallel maze generation
+// Note: Uses POSIX threads (pthreads); link with -pthread. On Windows, MinGW-w64
+// ships winpthreads, so the same code builds there.
+//
+// Each parallel loop splits its index range evenly across the workers. A worker
+// takes indices from the front of its own range; when that runs dry it steals the
+// back half of another worker's range, so uneven jobs (e.g. a slow Wilson's board
+// next to fast Prim's boards) still keep every core busy.
+#ifndef MAZE_POOL_H
+#define MAZE_POOL_H
+
+#include <stddef.h>   // For size_t
+
+// Runs job 'index' of a parallel loop on worker 'worker' (0 .. threads - 1).
+// Worker numbers let jobs use per-worker state, such as one MazeContext each.
+typedef void (*MazePoolTask)(void *user, size_t index, int worker);
+
+typedef struct MazePool MazePool; // Opaque; see maze-pool.c
+
+// --- Function Prototypes ---
+int getMazeProcessorCount();    // Online CPU count (at least 1)
+MazePool* createMazePool(int threads);  // Starts threads - 1 workers; the caller is worker 0
+int getMazePoolThreads(const MazePool *pool);   // Worker count including the caller
+void mazePoolParallelFor(MazePool *pool, size_t count, MazePoolTask task, void *user); // Runs task(0..count-1), returns when all are done
+void destroyMazePool(MazePool *pool);   // Stops and joins the workers
+
+#endif // MAZE_POOL_H
@@ -0,0 +1,378 @@
+// C-MAZE TERM - Terminal backend: keyboard, cursor, colors and screen
+// See maze-term.h for the color scheme and key codes.
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L // For poll(), nanosleep(), sigaction(), clock_gettime()
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <conio.h>    // For _getch(), _kbhit()
+#include <windows.h>  // For console handles, Sleep()
+#else
+#include <errno.h>
+#include <poll.h>     // For poll()
+#include <signal.h>   // For sigaction(), raise()
+#include <sys/ioctl.h> // For ioctl(TIOCGWINSZ)
+#include <termios.h>  // For tcgetattr(), tcsetattr()
+#include <time.h>     // For nanosleep(), clock_gettime()
+#include <unistd.h>   // For read(), write()
+#endif
+
+#include "maze-term.h"
+
+#define MAZE_TERM_ESCAPE_WAIT_MS 30 // Time for the rest of an escape sequence to arrive
+#define MAZE_TERM_DEFAULT_COLS 80   // Size assumed when the terminal does not report one
+#define MAZE_TERM_DEFAULT_ROWS 24
+
+// === PALETTE FUNCTIONS ===
+
+// RGB values of the 16 classic palette entries (xterm defaults).
+static const unsigned char classicPalette[16][3] = {
+    {0, 0, 0}, {128, 0, 0}, {0, 128, 0}, {128, 128, 0}, {0, 0, 128}, {128, 0, 128}, {0, 128, 128}, {192, 192, 192},
+    {128, 128, 128}, {255, 0, 0}, {0, 255, 0}, {255, 255, 0}, {0, 0, 255}, {255, 0, 255}, {0, 255, 255}, {255, 255, 255}
+};
+
+// RGB value of palette entry 'index' (0-255).
+static void getPaletteRgb(int index, int rgb[3]) {
+    static const int cubeLevels[6] = {0, 95, 135, 175, 215, 255};
+    if (index < 16) {
+        for (int i = 0; i < 3; i++) rgb[i] = classicPalette[index][i];
+    } else if (index < 232) {
+        index -= 16;
+        rgb[0] = cubeLevels[index / 36];
+        rgb[1] = cubeLevels[(index / 6) % 6];
+        rgb[2] = cubeLevels[index % 6];
+    } else {
+        rgb[0] = rgb[1] = rgb[2] = 8 + 10 * (index - 232);
+    }
+}
+
+// Windows console color (blue = 1, green = 2, red = 4, intensity = 8) nearest to palette entry 'index'.
+static int getConsoleColor(int index) {
+    int classic = index;
+    if (index >= 16) {
+        int rgb[3];
+        long best = -1;
+        getPaletteRgb(index, rgb);
+        for (int i = 0; i < 16; i++) {
+            long dr = rgb[0] - classicPalette[i][0];
+            long dg = rgb[1] - classicPalette[i][1];
+            long db = rgb[2] - classicPalette[i][2];
+            long distance = dr * dr + dg * dg + db * db;
+            if (best < 0 || distance < best) {
+                best = distance;
+                classic = i;
+            }
+        }
+    }
+    // ANSI order is red = 1, blue = 4; the console swaps them
+    return ((classic & 1) ? 4 : 0) | (classic & 2) | ((classic & 4) ? 1 : 0) | (classic & 8);
+}
+
+/*
+ * Console attribute (foreground in bits 0-3, background in bits 4-7) closest to 'color'.
+ * Used on Windows, whose console only has 16 colors.
+ */
+int getMazeConsoleAttribute(MazeColor color) {
+    return getConsoleColor(MAZE_COLOR_FG(color)) | (getConsoleColor(MAZE_COLOR_BG(color)) << 4);
+}
+
+#ifdef _WIN32
+
+// === WINDOWS CONSOLE FUNCTIONS ===
+
+static HANDLE termConsole = INVALID_HANDLE_VALUE;
+
+// Gets the console output handle. Keyboard input needs no setup (_getch() is unbuffered).
+int openMazeTerm(void) {
+    termConsole = GetStdHandle(STD_OUTPUT_HANDLE);
+    if (termConsole == INVALID_HANDLE_VALUE) {
+        perror("Error getting console handle");
+        return 0;
+    }
+    return 1;
+}
+
+void closeMazeTerm(void) {
+    fflush(stdout);
+}
+
+int mazeTermKeyPending(void) {
+    return _kbhit();
+}
+
+/*
+ * Blocks on the console input handle until a key is available or 'milliseconds' pass
+ * (< 0 waits forever). The handle is also signaled by mouse, focus and key release
+ * events; those are discarded so they don't wake the caller or spin the wait.
+ * Returns 1 if a key is ready, 0 on timeout.
+ */
+int waitMazeTermKey(int milliseconds) {
+    HANDLE input = GetStdHandle(STD_INPUT_HANDLE);
+    long long deadline = getMazeTermMillis() + milliseconds;
+    while (!_kbhit()) {
+        long long left = (milliseconds < 0) ? -1 : deadline - getMazeTermMillis();
+        if (milliseconds >= 0 && left <= 0) return 0;
+        if (WaitForSingleObject(input, (milliseconds < 0) ? INFINITE : (DWORD)left) != WAIT_OBJECT_0) return 0;
+
+        // --- Drop events that are not characters, one at a time ---
+        INPUT_RECORD record;
+        DWORD count = 0;
+        if (!_kbhit() && GetNumberOfConsoleInputEvents(input, &count) && count > 0) {
+            ReadConsoleInputA(input, &record, 1, &count);
+        }
+    }
+    return 1;
+}
+
+long long getMazeTermMillis(void) {
+    return (long long)GetTickCount64();
+}
+
+/*
+ * Reads one key. Arrow keys arrive as a 0 or 224 prefix followed by a scan code and are
+ * returned as MAZE_KEY_*; other extended keys are returned as 0.
+ */
+int readMazeTermKey(void) {
+    int key = _getch();
+    if (key != 0 && key != 224) return key;
+    switch (_getch()) {
+        case 72: return MAZE_KEY_UP;
+        case 80: return MAZE_KEY_DOWN;
+        case 75: return MAZE_KEY_LEFT;
+        case 77: return MAZE_KEY_RIGHT;
+        default: return 0;
+    }
+}
+
+char* readMazeTermLine(char *buffer, int size) {
+    return fgets(buffer, size, stdin);
+}
+
+void setMazeTermCursor(int col, int row) {
+    COORD coord = {(SHORT)col, (SHORT)row};
+    SetConsoleCursorPosition(termConsole, coord);
+}
+
+void showMazeTermCursor(int show) {
+    CONSOLE_CURSOR_INFO cursorInfo;
+    GetConsoleCursorInfo(termConsole, &cursorInfo);
+    cursorInfo.bVisible = show;
+    SetConsoleCursorInfo(termConsole, &cursorInfo);
+}
+
+void setMazeTermColor(MazeColor color) {
+    SetConsoleTextAttribute(termConsole, (WORD)getMazeConsoleAttribute(color));
+}
+
+void clearMazeTermScreen(void) {
+    system("cls");
+}
+
+// Size of the visible console window (not the whole scrollback buffer).
+void getMazeTermSize(int *cols, int *rows) {
+    CONSOLE_SCREEN_BUFFER_INFO info;
+    if (!GetConsoleScreenBufferInfo(termConsole, &info)) {
+        *cols = MAZE_TERM_DEFAULT_COLS;
+        *rows = MAZE_TERM_DEFAULT_ROWS;
+        return;
+    }
+    *cols = info.srWindow.Right - info.srWindow.Left + 1;
+    *rows = info.srWindow.Bottom - info.srWindow.Top + 1;
+}
+
+void sleepMazeTerm(int milliseconds) {
+    fflush(stdout);
+    Sleep((DWORD)milliseconds);
+}
+
+int writeMazeTerm(const char *data, size_t size) {
+    return fwrite(data, 1, size, stdout) == size && fflush(stdout) == 0;
+}
+
+#else
+
+// === POSIX TERMINAL FUNCTIONS ===
+
+static struct termios savedTermios; // Settings to restore at exit
+static int termRaw = 0;             // 1 while savedTermios must be restored
+
+// Restores the terminal and re-raises the signal, so Ctrl+C never leaves it in raw mode.
+static void handleMazeTermSignal(int signalNumber) {
+    static const char reset[] = "\x1b[0m\x1b[?25h";
+    if (termRaw) tcsetattr(STDIN_FILENO, TCSAFLUSH, &savedTermios);
+    if (write(STDOUT_FILENO, reset, sizeof(reset) - 1) < 0) { /* Nothing left to do */ }
+    signal(signalNumber, SIG_DFL);
+    raise(signalNumber);
+}
+
+// Applies raw mode (no echo, no line buffering) on top of the saved settings.
+static int applyMazeTermRaw(void) {
+    struct termios raw = savedTermios;
+    raw.c_lflag &= ~(tcflag_t)(ICANON | ECHO);
+    raw.c_cc[VMIN] = 1;
+    raw.c_cc[VTIME] = 0;
+    return tcsetattr(STDIN_FILENO, TCSANOW, &raw) == 0;
+}
+
+/*
+ * Switches the keyboard to raw mode: no echo, keys delivered one at a time. Ctrl+C
+ * still works. The terminal is restored at exit and on SIGINT/SIGTERM.
+ * Returns 1 on success, 0 if stdin is not a terminal.
+ */
+int openMazeTerm(void) {
+    static int registered = 0;
+    if (tcgetattr(STDIN_FILENO, &savedTermios) != 0) {
+        perror("Error reading terminal settings");
+        return 0;
+    }
+    if (!applyMazeTermRaw()) {
+        perror("Error setting terminal raw mode");
+        return 0;
+    }
+    termRaw = 1;
+
+    if (!registered) {
+        struct sigaction action;
+        action.sa_handler = handleMazeTermSignal;
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = 0;
+        sigaction(SIGINT, &action, NULL);
+        sigaction(SIGTERM, &action, NULL);
+        atexit(closeMazeTerm);
+        registered = 1;
+    }
+    return 1;
+}
+
+// Resets colors, shows the cursor and restores the saved terminal settings.
+void closeMazeTerm(void) {
+    if (!termRaw) return;
+    printf("\x1b[0m\x1b[?25h");
+    fflush(stdout);
+    tcsetattr(STDIN_FILENO, TCSAFLUSH, &savedTermios);
+    termRaw = 0;
+}
+
+/*
+ * Sleeps in poll() on stdin until a key arrives or 'milliseconds' pass (< 0 waits
+ * forever), using no CPU meanwhile. Returns 1 if a key is ready, 0 on timeout.
+ */
+int waitMazeTermKey(int milliseconds) {
+    struct pollfd input = {STDIN_FILENO, POLLIN, 0};
+    int ready;
+    do {
+        ready = poll(&input, 1, milliseconds);
+    } while (ready < 0 && errno == EINTR);
+    return ready > 0;
+}
+
+int mazeTermKeyPending(void) {
+    return waitMazeTermKey(0);
+}
+
+long long getMazeTermMillis(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (long long)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+// One byte from stdin; -1 at end of input.
+static int readMazeTermByte(void) {
+    unsigned char byte;
+    ssize_t got;
+    do {
+        got = read(STDIN_FILENO, &byte, 1);
+    } while (got < 0 && errno == EINTR);
+    return got == 1 ? byte : -1;
+}
+
+/*
+ * Reads one key. Arrow keys arrive as ESC [ A..D (or ESC O A..D) and are returned as
+ * MAZE_KEY_*; an ESC not followed by a known sequence is returned as 27.
+ * Returns -1 at end of input.
+ */
+int readMazeTermKey(void) {
+    fflush(stdout); // Show everything printed so far before blocking
+    int key = readMazeTermByte();
+    if (key != 27 || !waitMazeTermKey(MAZE_TERM_ESCAPE_WAIT_MS)) return key;
+
+    int introducer = readMazeTermByte();
+    if ((introducer != '[' && introducer != 'O') || !waitMazeTermKey(MAZE_TERM_ESCAPE_WAIT_MS)) return 27;
+    switch (readMazeTermByte()) {
+        case 'A': return MAZE_KEY_UP;
+        case 'B': return MAZE_KEY_DOWN;
+        case 'D': return MAZE_KEY_LEFT;
+        case 'C': return MAZE_KEY_RIGHT;
+        default:  return 27;
+    }
+}
+
+// fgets() on stdin with the terminal back in line mode (echo, editing) for the duration.
+char* readMazeTermLine(char *buffer, int size) {
+    fflush(stdout);
+    if (termRaw) tcsetattr(STDIN_FILENO, TCSANOW, &savedTermios);
+    char *line = fgets(buffer, size, stdin);
+    if (termRaw) applyMazeTermRaw();
+    return line;
+}
+
+void setMazeTermCursor(int col, int row) {
+    printf("\x1b[%d;%dH", row + 1, col + 1);
+}
+
+void showMazeTermCursor(int show) {
+    printf(show ? "\x1b[?25h" : "\x1b[?25l");
+}
+
+void setMazeTermColor(MazeColor color) {
+    printf("\x1b[38;5;%d;48;5;%dm", MAZE_COLOR_FG(color), MAZE_COLOR_BG(color));
+}
+
+void clearMazeTermScreen(void) {
+    printf("\x1b[0m\x1b[2J\x1b[H");
+    fflush(stdout);
+}
+
+// Terminal size from the TIOCGWINSZ ioctl; cheap enough to call every frame.
+void getMazeTermSize(int *cols, int *rows) {
+    struct winsize size;
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) != 0 || size.ws_col == 0 || size.ws_row == 0) {
+        *cols = MAZE_TERM_DEFAULT_COLS;
+        *rows = MAZE_TERM_DEFAULT_ROWS;
+        return;
+    }
+    *cols = size.ws_col;
+    *rows = size.ws_row;
+}
+
+void sleepMazeTerm(int milliseconds) {
+    struct timespec delay = {milliseconds / 1000, (long)(milliseconds % 1000) * 1000000L};
+    fflush(stdout);
+    while (nanosleep(&delay, &delay) != 0 && errno == EINTR) {
+        // Keep sleeping for the remaining time
+    }
+}
+
+/*
+ * Writes 'data' straight to the terminal, after anything still buffered in stdout.
+ * Returns 1 on success, 0 on error (reported).
+ */
+int writeMazeTerm(const char *data, size_t size) {
+    fflush(stdout);
+    while (size > 0) {
+        ssize_t written = write(STDOUT_FILENO, data, size);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            perror("Error writing to terminal");
+            return 0;
+        }
+        data += written;
+        size -= (size_t)written;
+    }
+    return 1;
+}
+
+#endif
@@ -0,0 +1,63 @@
+// C-MAZE TERM - Terminal backend: keyboard, cursor, colors and screen
+// Note: Windows console API on _WIN32; termios raw mode and ANSI/VT escapes elsewhere.
+//
+// Colors are xterm 256-color palette indices (0-15 the classic colors, 16-231 a 6x6x6
+// RGB cube, 232-255 grays), packed as foreground | background << 8. VT terminals get
+// them as is; the Windows console shows the nearest of its 16 colors.
+#ifndef MAZE_TERM_H
+#define MAZE_TERM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// --- Colors ---
+typedef uint16_t MazeColor; // Foreground | background << 8, both 256-color palette indices
+
+#define MAZE_COLOR(fg, bg) ((MazeColor)((fg) | ((bg) << 8)))
+#define MAZE_COLOR_FG(color) ((int)((color) & 0xFF))
+#define MAZE_COLOR_BG(color) ((int)((color) >> 8))
+
+// Classic palette entries (same on every terminal)
+#define MAZE_BLACK          0
+#define MAZE_RED            1
+#define MAZE_GREEN          2
+#define MAZE_YELLOW         3   // Olive / dark yellow
+#define MAZE_BLUE           4
+#define MAZE_MAGENTA        5
+#define MAZE_CYAN           6
+#define MAZE_WHITE          7   // Light gray
+#define MAZE_BRIGHT_RED     9
+#define MAZE_BRIGHT_GREEN   10
+#define MAZE_BRIGHT_YELLOW  11
+#define MAZE_BRIGHT_BLUE    12
+#define MAZE_BRIGHT_MAGENTA 13
+#define MAZE_BRIGHT_CYAN    14
+
+// Palette index of RGB cube entry (r, g, b), each 0-5
+#define MAZE_RGB(r, g, b) (16 + 36 * (r) + 6 * (g) + (b))
+
+// --- Keys ---
+// readMazeTermKey() returns plain characters as themselves (0-255) and these for arrows
+#define MAZE_KEY_UP    0x101
+#define MAZE_KEY_DOWN  0x102
+#define MAZE_KEY_LEFT  0x103
+#define MAZE_KEY_RIGHT 0x104
+
+// --- Function Prototypes ---
+int openMazeTerm(void);     // Raw keyboard input; restored at exit. 1 on success
+void closeMazeTerm(void);   // Restores the terminal (safe to call twice)
+int mazeTermKeyPending(void);   // 1 if readMazeTermKey() would not block
+int waitMazeTermKey(int milliseconds);  // Sleeps until a key arrives (1) or the timeout passes (0); < 0 waits forever
+long long getMazeTermMillis(void);  // Monotonic clock in milliseconds, for timeouts
+int readMazeTermKey(void);  // Next key without echo (blocks); see MAZE_KEY_*
+char* readMazeTermLine(char *buffer, int size); // fgets() with echo, for prompts
+void setMazeTermCursor(int col, int row);   // Moves the cursor (0-based)
+void showMazeTermCursor(int show);  // Shows or hides the cursor
+void setMazeTermColor(MazeColor color); // Color of subsequent output
+void clearMazeTermScreen(void); // Clears the screen, cursor to the top left
+void getMazeTermSize(int *cols, int *rows);    // Visible size in characters (80 x 24 if unknown)
+void sleepMazeTerm(int milliseconds);   // Flushes output, then pauses
+int writeMazeTerm(const char *data, size_t size);   // Raw bytes after any buffered output; 1 on success
+int getMazeConsoleAttribute(MazeColor color);   // Nearest 16-color console attribute (Windows layout)
+
+#endif // MAZE_TERM_H
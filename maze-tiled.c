@@ -0,0 +1,232 @@
+// C-MAZE TILED - Parallel generation of huge boards in independent tiles
+// See maze-tiled.h for the scheme.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>   // For memcpy()
+
+#include "maze-tiled.h"
+
+// --- Structs ---
+// One tiled generation; tile tasks only read it, apart from their own worker context
+typedef struct {
+    MazeGrid *grid;         // Board being filled
+    MazeContext *workers;   // One generation context per pool worker
+    unsigned int seed;
+    int algorithm;
+    int cellRows, cellCols; // Lattice size of the whole board
+    int tilesDown, tilesAcross;
+} MazeTiledJob;
+
+// One parallel recursive division: leaf chambers, each divided by one pool task
+typedef struct {
+    MazeGrid *grid;
+    const MazeChamber *leaves;
+    unsigned int seed;
+} MazeDivisionJob;
+
+// === TILED GENERATION FUNCTIONS ===
+
+/*
+ * Lattice rectangle of tile 'tile': first row/column and size. The lattice is split
+ * evenly, so tile sizes differ by at most one cell and no thin leftover tile remains.
+ */
+static void getMazeTileBounds(const MazeTiledJob *job, size_t tile, int *row, int *col, int *rows, int *cols) {
+    int tileRow = (int)(tile / (size_t)job->tilesAcross);
+    int tileCol = (int)(tile % (size_t)job->tilesAcross);
+    *row = (int)((long long)tileRow * job->cellRows / job->tilesDown);
+    *col = (int)((long long)tileCol * job->cellCols / job->tilesAcross);
+    *rows = (int)((long long)(tileRow + 1) * job->cellRows / job->tilesDown) - *row;
+    *cols = (int)((long long)(tileCol + 1) * job->cellCols / job->tilesAcross) - *col;
+}
+
+// Pool task: generates tile 'index' on the worker's context and copies it into the board.
+static void generateMazeTile(void *user, size_t index, int worker) {
+    MazeTiledJob *job = (MazeTiledJob *)user;
+    MazeContext *ctx = &job->workers[worker];
+    int row, col, rows, cols;
+    getMazeTileBounds(job, index, &row, &col, &rows, &cols);
+
+    // --- Generate the tile as a small board of its own ---
+    int tileGridRows = 2 * rows + 1;
+    int tileGridCols = 2 * cols + 1;
+    if (ctx->grid.rows != tileGridRows || ctx->grid.cols != tileGridCols) {
+        freeMazeGrid(&ctx->grid);
+        allocateMazeGrid(&ctx->grid, tileGridRows, tileGridCols);
+    } else {
+        fillMazeGrid(&ctx->grid, WALL_CHAR);
+    }
+    mazeRngSeedStream(&ctx->rng, job->seed, 1 + (uint64_t)index);
+    generateMaze(ctx, job->algorithm, 1, 1);
+    MAZE_CELL(&ctx->grid, 1, 1) = PATH_CHAR;
+
+    // --- Copy its interior; the tile's border is the board's wall between tiles ---
+    for (int x = 1; x < tileGridRows - 1; x++) {
+        memcpy(&MAZE_CELL(job->grid, 2 * row + x, 2 * col + 1), &MAZE_CELL(&ctx->grid, x, 1), (size_t)(tileGridCols - 2));
+    }
+}
+
+// Root of tile 'i' in the tile union-find (iterative, with path halving).
+static uint32_t findMazeTileSet(uint32_t *parent, uint32_t i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+/*
+ * Joins the generated tiles into one spanning tree: Kruskal's over the tile grid picks
+ * a random spanning tree of tile boundaries, and each chosen boundary gets one passage
+ * at a random position along it. Draws from stream 0 of the seed.
+ * Returns 1 on success, 0 if memory could not be allocated.
+ */
+static int stitchMazeTiles(const MazeTiledJob *job) {
+    size_t tiles = (size_t)job->tilesDown * (size_t)job->tilesAcross;
+    uint32_t *edges = (uint32_t *)malloc(2 * tiles * sizeof(uint32_t));
+    uint32_t *parent = (uint32_t *)malloc(tiles * sizeof(uint32_t));
+    if (!edges || !parent) {
+        perror("Error allocating tile stitching buffers");
+        free(edges); free(parent);
+        return 0;
+    }
+
+    // --- Tile boundaries: (tile << 1) | 0 to the east neighbour, | 1 to the south one ---
+    size_t edgeCount = 0;
+    for (size_t t = 0; t < tiles; t++) {
+        parent[t] = (uint32_t)t;
+        if ((int)(t % (size_t)job->tilesAcross) + 1 < job->tilesAcross) edges[edgeCount++] = (uint32_t)(t << 1);
+        if ((int)(t / (size_t)job->tilesAcross) + 1 < job->tilesDown) edges[edgeCount++] = (uint32_t)((t << 1) | 1);
+    }
+
+    MazeRng rng;
+    mazeRngSeedStream(&rng, job->seed, 0);
+    for (size_t i = (edgeCount > 0 ? edgeCount - 1 : 0); i > 0; i--) { // Fisher-Yates
+        size_t j = mazeRandBelow(&rng, (uint32_t)(i + 1));
+        uint32_t temp = edges[i]; edges[i] = edges[j]; edges[j] = temp;
+    }
+
+    // --- Open one passage per boundary of the tile spanning tree ---
+    for (size_t i = 0; i < edgeCount; i++) {
+        uint32_t tile = edges[i] >> 1;
+        int south = (int)(edges[i] & 1);
+        uint32_t neighbour = south ? tile + (uint32_t)job->tilesAcross : tile + 1;
+        uint32_t rootA = findMazeTileSet(parent, tile);
+        uint32_t rootB = findMazeTileSet(parent, neighbour);
+        if (rootA == rootB) continue;
+        parent[rootB] = rootA;
+
+        int row, col, rows, cols;
+        getMazeTileBounds(job, tile, &row, &col, &rows, &cols);
+        if (south) {
+            int c = col + (int)mazeRandBelow(&rng, (uint32_t)cols);
+            MAZE_CELL(job->grid, 2 * (row + rows), 2 * c + 1) = PATH_CHAR;
+        } else {
+            int r = row + (int)mazeRandBelow(&rng, (uint32_t)rows);
+            MAZE_CELL(job->grid, 2 * r + 1, 2 * (col + cols)) = PATH_CHAR;
+        }
+    }
+
+    free(edges);
+    free(parent);
+    return 1;
+}
+
+// Pool task: divides leaf chamber 'index' completely with its own random stream.
+static void divideMazeLeaf(void *user, size_t index, int worker) {
+    MazeDivisionJob *job = (MazeDivisionJob *)user;
+    MazeRng rng;
+    (void)worker;
+    mazeRngSeedStream(&rng, job->seed, 1 + (uint64_t)index);
+    divideMazeChamber(&rng, job->grid, job->leaves[index]);
+}
+
+/*
+ * Recursive division in parallel: the first levels are divided here, breadth first with
+ * stream 0 of the seed, until every chamber has at most tileCells x tileCells cells.
+ * These leaf chambers don't overlap and are then divided on the pool, leaf i with
+ * stream 1 + i. Returns 1 on success, 0 if memory could not be allocated.
+ */
+static int generateDividedMaze(MazePool *pool, MazeGrid *grid, unsigned int seed, int tileCells) {
+    long long leafArea = (long long)tileCells * tileCells;
+    size_t capacity = 64;
+    MazeChamber *queue = (MazeChamber *)malloc(capacity * sizeof(MazeChamber));
+    if (!queue) {
+        perror("Error allocating division queue");
+        return 0;
+    }
+
+    // --- Split serially into leaves; the queue holds pending chambers, then the leaves ---
+    MazeRng rng;
+    mazeRngSeedStream(&rng, seed, 0);
+    openMazeField(grid);
+    queue[0] = (MazeChamber){0, 0, (grid->rows - 1) / 2, (grid->cols - 1) / 2};
+    size_t head = 0, tail = 1;  // Pending chambers: queue[head .. tail - 1]
+    size_t leafCount = 0;       // Leaves: queue[0 .. leafCount - 1] (always <= head)
+    while (head < tail) {
+        MazeChamber chamber = queue[head++];
+        MazeChamber halves[2];
+        if ((long long)chamber.rows * chamber.cols <= leafArea || !splitMazeChamber(&rng, grid, chamber, halves)) {
+            queue[leafCount++] = chamber;
+            continue;
+        }
+        if (tail + 2 > capacity) {
+            MazeChamber *grown = (MazeChamber *)realloc(queue, 2 * capacity * sizeof(MazeChamber));
+            if (!grown) {
+                perror("Error allocating division queue");
+                free(queue);
+                return 0;
+            }
+            queue = grown;
+            capacity *= 2;
+        }
+        queue[tail++] = halves[0];
+        queue[tail++] = halves[1];
+    }
+
+    MazeDivisionJob job = {grid, queue, seed};
+    mazePoolParallelFor(pool, leafCount, divideMazeLeaf, &job);
+    free(queue);
+    return 1;
+}
+
+/*
+ * Generates a maze into 'grid' (allocated, all walls) from tiles of 'tileCells' lattice
+ * cells per side (values < 1 mean MAZE_TILE_DEFAULT_CELLS), run in parallel on 'pool'.
+ * The result depends only on seed, algorithm, board size and tile size, not on the
+ * number of threads. It differs from generateMaze() with the same seed.
+ * Only algorithms that connect every cell of a tile can be used. Recursive division
+ * needs no stitching: it is split top-down into chambers of at most tileCells x
+ * tileCells cells instead, which are then divided in parallel.
+ * Returns 1 on success, 0 on error (reported).
+ */
+int generateTiledMaze(MazePool *pool, MazeGrid *grid, unsigned int seed, int algorithm, int tileCells) {
+    if (!algorithmGuaranteesConnectivity(algorithm)) {
+        fprintf(stderr, "Error: Tiled generation needs an algorithm that connects every cell.\n");
+        return 0;
+    }
+    if (tileCells < 1) tileCells = MAZE_TILE_DEFAULT_CELLS;
+    if (algorithm == ALGORITHM_RECURSIVE_DIVISION) return generateDividedMaze(pool, grid, seed, tileCells);
+
+    MazeTiledJob job;
+    job.grid = grid;
+    job.seed = seed;
+    job.algorithm = algorithm;
+    job.cellRows = (grid->rows - 1) / 2;
+    job.cellCols = (grid->cols - 1) / 2;
+    job.tilesDown = (job.cellRows + tileCells - 1) / tileCells;
+    job.tilesAcross = (job.cellCols + tileCells - 1) / tileCells;
+    if (job.tilesDown < 1 || job.tilesAcross < 1) return 1; // No lattice cells
+
+    int threads = getMazePoolThreads(pool);
+    job.workers = (MazeContext *)calloc((size_t)threads, sizeof(MazeContext));
+    if (!job.workers) {
+        perror("Error allocating tile contexts");
+        return 0;
+    }
+
+    mazePoolParallelFor(pool, (size_t)job.tilesDown * (size_t)job.tilesAcross, generateMazeTile, &job);
+
+    for (int i = 0; i < threads; i++) freeMazeContext(&job.workers[i]);
+    free(job.workers);
+    return stitchMazeTiles(&job);
+}
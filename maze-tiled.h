@@ -0,0 +1,23 @@
+// C-MAZE TILED - Parallel generation of huge boards in independent tiles
+// Note: Runs the tiles on a work-stealing pool (maze-pool.h); link with -pthread.
+//
+// The lattice is cut into square tiles of 'tileCells' x 'tileCells' cells. Each tile is
+// generated on its own by one of the engine's algorithms, with a random sequence of its
+// own (mazeRngSeedStream(seed, 1 + tile index)), so the result never depends on which
+// thread ran which tile. A random spanning tree over the tiles (Kruskal's with a
+// union-find) then opens exactly one passage through each boundary it uses, joining the
+// tiles' spanning trees into one: every cell stays reachable from every other.
+// Recursive division splits top-down instead, so its chambers are generated in
+// parallel the same way without any stitching.
+#ifndef MAZE_TILED_H
+#define MAZE_TILED_H
+
+#include "maze-engine.h"
+#include "maze-pool.h"
+
+#define MAZE_TILE_DEFAULT_CELLS 256 // Lattice cells per tile side
+
+// --- Function Prototypes ---
+int generateTiledMaze(MazePool *pool, MazeGrid *grid, unsigned int seed, int algorithm, int tileCells); // Fills an all-wall grid; 1 on success
+
+#endif // MAZE_TILED_H